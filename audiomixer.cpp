@@ -0,0 +1,593 @@
+// audiomixer.cpp
+#include "audiomixer.h"
+
+#include <QAudioBuffer>
+#include <QAudioDecoder>
+#include <QAudioDevice>
+#include <QAudioSink>
+#include <QDebug>
+#include <QFile>
+#include <QIODevice>
+#include <QMediaDevices>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace {
+
+// Samples per decoded part; a whole number of frames.
+qint64 partSamples(const QAudioFormat& format) {
+    return qint64(format.sampleRate()) * AudioMixer::PART_MS / 1000 * format.channelCount();
+}
+
+// Sample i of a decoded buffer, scaled to [-1, 1].
+float sampleAt(const QAudioBuffer& buf, qint64 i) {
+    switch (buf.format().sampleFormat()) {
+    case QAudioFormat::UInt8: return (int(buf.constData<quint8>()[i]) - 128) / 128.0f;
+    case QAudioFormat::Int16: return buf.constData<qint16>()[i] / 32768.0f;
+    case QAudioFormat::Int32: return float(buf.constData<qint32>()[i] / 2147483648.0);
+    case QAudioFormat::Float: return buf.constData<float>()[i];
+    default:                  return 0.0f;
+    }
+}
+
+// Decoder backends may hand back a different format than the one asked for.
+// This brings such buffers to the sink's sample format, channel count and rate;
+// the rate is resampled linearly, carrying the last frame over so buffer joins
+// stay smooth.
+class PcmConverter {
+public:
+    explicit PcmConverter(const QAudioFormat& out) : m_out(out), m_prev(out.channelCount(), 0.0f) {}
+
+    static bool matches(const QAudioFormat& in, const QAudioFormat& out) {
+        return in.sampleFormat() == QAudioFormat::Int16 && in.channelCount() == out.channelCount()
+            && in.sampleRate() == out.sampleRate();
+    }
+
+    // False if the buffer's format cannot be read at all.
+    bool convert(const QAudioBuffer& buf, QVector<qint16>& out) {
+        const QAudioFormat in = buf.format();
+        const int inCh = in.channelCount();
+        const int outCh = m_out.channelCount();
+        if (inCh <= 0 || in.sampleRate() <= 0 || in.sampleFormat() == QAudioFormat::Unknown) return false;
+
+        const qint64 frames = buf.frameCount();
+        m_frames.resize(frames * outCh);
+        for (qint64 f = 0; f < frames; ++f) {
+            for (int ch = 0; ch < outCh; ++ch) {
+                float v = 0.0f;
+                if (outCh == 1) {
+                    for (int c = 0; c < inCh; ++c) v += sampleAt(buf, f * inCh + c);
+                    v /= inCh;
+                } else {
+                    v = sampleAt(buf, f * inCh + ch % inCh);
+                }
+                m_frames[f * outCh + ch] = v;
+            }
+        }
+
+        // Frame -1 is the previous buffer's last one.
+        auto frame = [&](qint64 k) { return k < 0 ? m_prev.constData() : m_frames.constData() + k * outCh; };
+        const double step = double(in.sampleRate()) / m_out.sampleRate();
+        out.clear();
+        for (; m_pos < double(frames - 1); m_pos += step) {
+            const qint64 k = qint64(std::floor(m_pos));
+            const float a = float(m_pos - k);
+            const float* x0 = frame(k);
+            const float* x1 = frame(k + 1);
+            for (int ch = 0; ch < outCh; ++ch) {
+                const float v = x0[ch] + (x1[ch] - x0[ch]) * a;
+                out.append(qint16(std::clamp(std::lrint(v * 32767.0f), -32768L, 32767L)));
+            }
+        }
+        m_pos -= double(frames);
+        if (frames > 0) std::copy_n(frame(frames - 1), outCh, m_prev.data());
+        return true;
+    }
+
+private:
+    QAudioFormat m_out;
+    QVector<float> m_prev;
+    QVector<float> m_frames;
+    double m_pos = 0.0; // next output position, in input frames from the current buffer's start
+};
+
+} // namespace
+
+// Lives on the mixer thread: owns the sink, the loaded sounds and the voices,
+// and renders the mix whenever the sink pulls more data.
+class MixerEngine : public QIODevice {
+public:
+    using Commands = SpscQueue<AudioMixer::Command, 256>;
+
+    MixerEngine(const QAudioFormat& format, Commands& commands)
+        : m_format(format), m_channels(format.channelCount()), m_partSamples(partSamples(format)),
+          m_commands(commands) {}
+
+    void start() {
+        open(QIODevice::ReadOnly);
+        m_sink = new QAudioSink(m_format, this);
+        // About 20 ms of buffering keeps a play request audible within a frame or two.
+        m_sink->setBufferSize(m_format.bytesForDuration(20000));
+        m_sink->start(this);
+    }
+
+    // Swaps in the cache mapping of an already decoded (or not yet loaded) sound.
+    void setMapped(int id, const PcmCache::Mapped& mapped);
+
+    qint64 bytesAvailable() const override {
+        return m_format.bytesForDuration(20000) + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override;
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    struct Sound {
+        // Streaming: parts are still arriving from the decoder.
+        enum State : quint8 { Pending, Streaming, Ready, Failed } state = Pending;
+        QVector<QVector<qint16>> parts; // freshly decoded, until the cache file is mapped
+        qint64 decoded = 0;
+        PcmCache::Mapped mapped;
+        bool unloaded = false;          // late parts and mappings are discarded
+        qint64 size() const { return mapped.isValid() ? mapped.count : decoded; }
+        // Samples from pos to the end of the contiguous run holding it.
+        const qint16* at(qint64 pos, qint64 partSamples, qint64& run) const {
+            if (mapped.isValid()) { run = mapped.count - pos; return mapped.samples + pos; }
+            const QVector<qint16>& part = parts[pos / partSamples];
+            const qint64 off = pos % partSamples;
+            run = part.size() - off;
+            return part.constData() + off;
+        }
+    };
+
+    struct Voice {
+        int    sound  = -1;
+        qint64 pos    = 0;     // in samples (frames * channels)
+        float  gain   = 0.0f;
+        float  target = 0.0f;
+        float  step   = 0.0f;  // per frame, towards target
+        int    tag    = 0;
+        bool   loop   = false;
+        bool   active = false;
+    };
+
+    void apply(const AudioMixer::Command& c);
+    void releaseUnloaded();
+    void rampTo(Voice& v, float target, int ms) const;
+    Voice* voiceWithTag(int tag);
+    Voice* freeVoice();
+    Sound& sound(int id);
+
+    QAudioFormat m_format;
+    int m_channels;
+    qint64 m_partSamples;
+    Commands& m_commands;
+    QAudioSink* m_sink = nullptr;
+    QVector<Sound> m_sounds;
+    QVector<int> m_unloading;       // unloaded, but a voice may still be fading it out
+    std::array<Voice, AudioMixer::MAX_VOICES> m_voices;
+    QVector<float> m_mix;
+};
+
+void MixerEngine::setMapped(int id, const PcmCache::Mapped& mapped) {
+    Sound& s = sound(id);
+    if (s.unloaded) return;
+    // Same samples as the decoded copy, so voices already playing carry on.
+    s.mapped  = mapped;
+    s.parts   = {};
+    s.decoded = 0;
+    s.state   = Sound::Ready;
+}
+
+MixerEngine::Sound& MixerEngine::sound(int id) {
+    if (id >= m_sounds.size()) m_sounds.resize(id + 1);
+    return m_sounds[id];
+}
+
+MixerEngine::Voice* MixerEngine::voiceWithTag(int tag) {
+    if (tag == 0) return nullptr;
+    for (Voice& v : m_voices) {
+        if (v.active && v.tag == tag) return &v;
+    }
+    return nullptr;
+}
+
+MixerEngine::Voice* MixerEngine::freeVoice() {
+    Voice* oldest = nullptr;
+    for (Voice& v : m_voices) {
+        if (!v.active) return &v;
+        if (!v.loop && (!oldest || v.pos > oldest->pos)) oldest = &v;
+    }
+    // All voices busy: steal the one-shot that has played longest.
+    return oldest;
+}
+
+void MixerEngine::rampTo(Voice& v, float target, int ms) const {
+    const float frames = std::max(1.0f, float(m_format.sampleRate()) * ms / 1000.0f);
+    v.target = target;
+    v.step   = (target - v.gain) / frames;
+    // Already there: nothing to ramp, and a voice faded to silence is done.
+    if (v.step == 0.0f && target <= 0.0f) v.active = false;
+}
+
+void MixerEngine::apply(const AudioMixer::Command& c) {
+    if (c.type == AudioMixer::Command::Part) {
+        Sound& s = sound(c.sound);
+        // The cache mapping can overtake the last parts; it holds them already.
+        if (!s.mapped.isValid() && !s.unloaded) {
+            s.decoded += c.part->size();
+            s.parts.append(std::move(*c.part));
+            s.state = Sound::Streaming;
+        }
+        delete c.part;
+        return;
+    }
+    if (c.type == AudioMixer::Command::Loaded || c.type == AudioMixer::Command::LoadFailed) {
+        Sound& s = sound(c.sound);
+        if (s.mapped.isValid() || s.unloaded) return;
+        if (c.type == AudioMixer::Command::LoadFailed || s.decoded == 0) {
+            s.parts = {};
+            s.decoded = 0;
+            s.state = Sound::Failed;
+        } else {
+            s.state = Sound::Ready;
+        }
+        return;
+    }
+    if (c.type == AudioMixer::Command::Unload) {
+        Sound& s = sound(c.sound);
+        if (!s.unloaded) {
+            s.unloaded = true;
+            m_unloading.append(c.sound);
+        }
+        return;
+    }
+
+    Voice* v = voiceWithTag(c.tag);
+
+    if (c.type == AudioMixer::Command::Fade) {
+        if (v) rampTo(*v, 0.0f, c.fadeMs);
+        return;
+    }
+    if (c.type == AudioMixer::Command::Gain) {
+        if (v && v->step == 0.0f) v->gain = v->target = c.gain;
+        return;
+    }
+
+    if (v && c.mode == AudioMixer::Mode::Loop && v->sound == c.sound) {
+        if (c.fadeMs > 0) { rampTo(*v, c.gain, c.fadeMs); return; }
+        v->gain = v->target = c.gain;
+        v->step = 0.0f;
+        return;
+    }
+    if (v && c.fadeMs > 0) {
+        // Crossfade: the old voice loses its tag and fades out on its own.
+        v->tag = 0;
+        rampTo(*v, 0.0f, c.fadeMs);
+        v = nullptr;
+    }
+    if (!v || c.mode == AudioMixer::Mode::Overlap) v = freeVoice();
+    if (!v) return;
+
+    *v = Voice{};
+    v->sound  = c.sound;
+    v->gain   = v->target = c.gain;
+    v->tag    = c.tag;
+    v->loop   = (c.mode == AudioMixer::Mode::Loop);
+    v->active = true;
+    if (c.fadeMs > 0) {
+        v->gain = 0.0f;
+        rampTo(*v, c.gain, c.fadeMs);
+    }
+}
+
+qint64 MixerEngine::readData(char* data, qint64 maxlen) {
+    AudioMixer::Command c;
+    while (m_commands.pop(c)) apply(c);
+
+    const qint64 frames = maxlen / (qint64(sizeof(qint16)) * m_channels);
+    const qint64 samples = frames * m_channels;
+    if (frames <= 0) return 0;
+
+    if (m_mix.size() < samples) m_mix.resize(samples);
+    std::fill_n(m_mix.data(), samples, 0.0f);
+    float* mix = m_mix.data();
+
+    for (Voice& v : m_voices) {
+        if (!v.active) continue;
+        const Sound::State state = (v.sound >= 0 && v.sound < m_sounds.size())
+                                       ? m_sounds[v.sound].state : Sound::Failed;
+        if (state == Sound::Pending || state == Sound::Failed) {
+            // Loops (music) wait for their sound to load; late one-shots are dropped.
+            if (state == Sound::Failed || !v.loop) v.active = false;
+            continue;
+        }
+        const Sound& s = m_sounds[v.sound];
+        const qint64 len = s.size();
+        if (state == Sound::Ready && len < m_channels) { v.active = false; continue; }
+
+        qint64 f = 0;
+        while (f < frames && v.active) {
+            if (v.pos + m_channels > len) {
+                // Caught up with the decoder: hold here until the next part lands.
+                if (state == Sound::Streaming) break;
+                if (!v.loop) { v.active = false; break; }
+                v.pos = 0;
+            }
+            qint64 run = 0;
+            const qint16* src = s.at(v.pos, m_partSamples, run);
+            const qint64 n = f + std::min(frames - f, run / m_channels);
+            for (; f < n && v.active; ++f) {
+                for (int ch = 0; ch < m_channels; ++ch)
+                    mix[f * m_channels + ch] += float(src[ch]) * v.gain;
+                src   += m_channels;
+                v.pos += m_channels;
+
+                if (v.step != 0.0f) {
+                    v.gain += v.step;
+                    if ((v.step < 0.0f && v.gain <= v.target) || (v.step > 0.0f && v.gain >= v.target)) {
+                        v.gain = v.target;
+                        v.step = 0.0f;
+                        if (v.target <= 0.0f) v.active = false;
+                    }
+                }
+            }
+        }
+    }
+
+    qint16* out = reinterpret_cast<qint16*>(data);
+    for (qint64 i = 0; i < samples; ++i)
+        out[i] = qint16(std::clamp(std::lrint(mix[i]), -32768L, 32767L));
+    if (!m_unloading.isEmpty()) releaseUnloaded();
+    return samples * qint64(sizeof(qint16));
+}
+
+void MixerEngine::releaseUnloaded() {
+    for (qsizetype i = m_unloading.size() - 1; i >= 0; --i) {
+        const int id = m_unloading[i];
+        const bool playing = std::any_of(m_voices.begin(), m_voices.end(),
+                                         [id](const Voice& v) { return v.active && v.sound == id; });
+        if (playing) continue;
+        Sound& s = m_sounds[id];
+        s.parts   = {};
+        s.decoded = 0;
+        s.mapped  = {};
+        s.state   = Sound::Failed;
+        m_unloading.remove(i);
+    }
+}
+
+AudioMixer::AudioMixer(QObject* parent)
+    : QObject(parent)
+{
+    const QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    m_format = device.preferredFormat();
+    m_format.setSampleFormat(QAudioFormat::Int16);
+    if (!device.isFormatSupported(m_format)) {
+        m_format.setSampleRate(44100);
+        m_format.setChannelCount(2);
+    }
+
+    m_io.setMaxThreadCount(1);
+
+    m_backlogTimer.setInterval(20);
+    connect(&m_backlogTimer, &QTimer::timeout, this, &AudioMixer::flushLoadBacklog);
+
+    // QAudioDecoder needs an event loop, so decoding gets a thread rather than a pool slot.
+    m_decodeContext = new QObject;
+    m_decodeContext->moveToThread(&m_decodeThread);
+    connect(&m_decodeThread, &QThread::finished, m_decodeContext, &QObject::deleteLater);
+    m_decodeThread.setObjectName(QStringLiteral("AudioDecode"));
+    m_decodeThread.start(QThread::LowPriority);
+
+    m_engine = new MixerEngine(m_format, m_commands);
+    m_engine->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_engine, &QObject::deleteLater);
+    m_thread.setObjectName(QStringLiteral("AudioMixer"));
+    m_thread.start(QThread::TimeCriticalPriority);
+    QMetaObject::invokeMethod(m_engine, [e = m_engine] { e->start(); }, Qt::QueuedConnection);
+}
+
+AudioMixer::~AudioMixer() {
+    // Pool tasks and decoders report back to this object, so they finish first.
+    m_io.waitForDone();
+    m_decodeThread.quit();
+    m_decodeThread.wait();
+    m_thread.quit();
+    m_thread.wait();
+
+    // Parts the mixer never picked up.
+    for (const Command& c : std::as_const(m_loadBacklog)) delete c.part;
+    Command c;
+    while (m_commands.pop(c)) delete c.part;
+}
+
+int AudioMixer::load(const QUrl& src) {
+    const int id = m_nextSound++;
+    ++m_pending;
+    m_io.start([this, id, src, format = m_format] {
+        const QString key = PcmCache::keyFor(src, format);
+        const PcmCache::Mapped mapped = PcmCache::open(key);
+        QMetaObject::invokeMethod(this, [=] { cacheLookedUp(id, src, key, mapped); }, Qt::QueuedConnection);
+    });
+    return id;
+}
+
+void AudioMixer::cacheLookedUp(int id, const QUrl& src, const QString& key, const PcmCache::Mapped& mapped) {
+    if (mapped.isValid()) {
+        QMetaObject::invokeMethod(m_engine, [e = m_engine, id, mapped] { e->setMapped(id, mapped); },
+                                  Qt::QueuedConnection);
+        loadFinished();
+        return;
+    }
+    m_cacheKeys.insert(id, key);
+    QMetaObject::invokeMethod(m_decodeContext, [this, id, src] { decode(id, src); }, Qt::QueuedConnection);
+}
+
+// Runs on m_decodeThread. Samples are copied into parts reserved up front, and
+// each full part goes to the GUI thread and on to the mixer as it is.
+void AudioMixer::decode(int id, const QUrl& src) {
+    auto* decoder = new QAudioDecoder(m_decodeContext);
+    decoder->setAudioFormat(m_format);
+    decoder->setSource(src);
+
+    struct State {
+        explicit State(const QAudioFormat& f) : converter(f) {}
+        QVector<qint16> part;
+        PcmConverter converter;
+        QVector<qint16> converted;
+        bool warned = false;
+    };
+    const qint64 partLen = partSamples(m_format);
+    auto state = std::make_shared<State>(m_format);
+    auto publish = [this, id, state] {
+        if (state->part.isEmpty()) return;
+        QMetaObject::invokeMethod(this, [this, id, p = std::move(state->part)] { partDecoded(id, p); },
+                                  Qt::QueuedConnection);
+        state->part = {};
+    };
+    connect(decoder, &QAudioDecoder::bufferReady, m_decodeContext, [this, decoder, src, state, partLen, publish] {
+        const QAudioBuffer buf = decoder->read();
+        const QAudioFormat fmt = buf.format();
+        const qint16* in = buf.constData<qint16>();
+        qint64 left = buf.sampleCount();
+        if (!PcmConverter::matches(fmt, m_format)) {
+            const bool ok = state->converter.convert(buf, state->converted);
+            if (!state->warned) {
+                state->warned = true;
+                qWarning() << "AudioMixer:" << src.toString() << "decodes as" << fmt.sampleRate() << "Hz,"
+                           << fmt.channelCount() << "ch, format" << int(fmt.sampleFormat())
+                           << (ok ? "- converting to the output format" : "- unsupported, dropping it");
+            }
+            if (!ok) return;
+            in = state->converted.constData();
+            left = state->converted.size();
+        }
+        QVector<qint16>* part = &state->part;
+        while (left > 0) {
+            if (part->isEmpty()) part->reserve(partLen);
+            const qint64 n = std::min(left, partLen - part->size());
+            const qsizetype at = part->size();
+            part->resize(at + n);
+            std::memcpy(part->data() + at, in, size_t(n) * sizeof(qint16));
+            in += n;
+            left -= n;
+            if (part->size() == partLen) publish();
+        }
+    });
+    auto finish = [this, decoder, id](bool ok) {
+        QMetaObject::invokeMethod(this, [this, id, ok] { decodeFinished(id, ok); }, Qt::QueuedConnection);
+        decoder->disconnect(m_decodeContext);
+        decoder->deleteLater();
+    };
+    connect(decoder, &QAudioDecoder::finished, m_decodeContext, [finish, publish] { publish(); finish(true); });
+    connect(decoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error), m_decodeContext,
+            [finish] { finish(false); });
+    decoder->start();
+}
+
+void AudioMixer::partDecoded(int id, const QVector<qint16>& part) {
+    m_decodedParts[id].append(part);
+    Command c;
+    c.type  = Command::Part;
+    c.sound = id;
+    c.part  = new QVector<qint16>(part); // shares the samples, no copy
+    submitLoad(c);
+}
+
+void AudioMixer::decodeFinished(int id, bool ok) {
+    Command c;
+    c.type  = ok ? Command::Loaded : Command::LoadFailed;
+    c.sound = id;
+    submitLoad(c);
+
+    const QString key = m_cacheKeys.take(id);
+    const QVector<QVector<qint16>> parts = m_decodedParts.take(id);
+    if (ok && !key.isEmpty() && !parts.isEmpty()) {
+        // Write the cache file, then play from its mapping so the decoded copy can go.
+        m_io.start([this, id, key, parts] {
+            if (!PcmCache::store(key, parts)) return;
+            const PcmCache::Mapped mapped = PcmCache::open(key);
+            if (!mapped.isValid()) return;
+            QMetaObject::invokeMethod(this, [this, id, mapped] {
+                QMetaObject::invokeMethod(m_engine, [e = m_engine, id, mapped] { e->setMapped(id, mapped); },
+                                          Qt::QueuedConnection);
+            }, Qt::QueuedConnection);
+        });
+    }
+    loadFinished();
+}
+
+void AudioMixer::loadFinished() {
+    if (--m_pending == 0) emit ready();
+}
+
+void AudioMixer::play(int sound, float gain, int tag, Mode mode) {
+    Command c;
+    c.type  = Command::Play;
+    c.mode  = mode;
+    c.tag   = qint16(tag);
+    c.sound = sound;
+    c.gain  = gain;
+    submit(c);
+}
+
+void AudioMixer::crossfadeTo(int sound, float gain, int tag, int ms) {
+    Command c;
+    c.type   = Command::Play;
+    c.mode   = Mode::Loop;
+    c.tag    = qint16(tag);
+    c.sound  = sound;
+    c.gain   = gain;
+    c.fadeMs = ms;
+    submit(c);
+}
+
+void AudioMixer::fadeOut(int tag, int ms) {
+    Command c;
+    c.type   = Command::Fade;
+    c.tag    = qint16(tag);
+    c.fadeMs = ms;
+    submit(c);
+}
+
+void AudioMixer::setGain(int tag, float gain) {
+    Command c;
+    c.type = Command::Gain;
+    c.tag  = qint16(tag);
+    c.gain = gain;
+    submit(c);
+}
+
+void AudioMixer::unload(int sound) {
+    Command c;
+    c.type  = Command::Unload;
+    c.sound = sound;
+    submitLoad(c);
+}
+
+void AudioMixer::submit(const Command& c) {
+    // A full queue means the audio thread is stalled; dropping the request is
+    // better than blocking the game loop.
+    m_commands.push(c);
+}
+
+void AudioMixer::submitLoad(const Command& c) {
+    // A sound is only whole if every part arrives in order, and an unload that
+    // went missing would leak the track, so these are never dropped: while the
+    // queue is full they wait here and are retried.
+    if (m_loadBacklog.isEmpty() && m_commands.push(c)) return;
+    m_loadBacklog.append(c);
+    if (!m_backlogTimer.isActive()) m_backlogTimer.start();
+}
+
+void AudioMixer::flushLoadBacklog() {
+    while (!m_loadBacklog.isEmpty() && m_commands.push(m_loadBacklog.first()))
+        m_loadBacklog.removeFirst();
+    if (m_loadBacklog.isEmpty()) m_backlogTimer.stop();
+}
@@ -0,0 +1,102 @@
+// audiomixer.h
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <QObject>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <QHash>
+#include <QAudioFormat>
+#include <QUrl>
+#include <QVector>
+#include "spscqueue.h"
+#include "pcmcache.h"
+
+class MixerEngine;
+
+// Sounds decoded once to 16-bit PCM and mixed in software into a single
+// pull-mode QAudioSink running on the mixer's own thread. Decoding has a thread
+// of its own and hands the PCM over in PART_MS parts as it goes, so a long
+// track starts playing after its first part and the mixer never copies it.
+// Decoded PCM is written to PcmCache and memory-mapped on later launches, so
+// cached sounds (music included) play straight from the mapping with no decode.
+// Playback requests are plain structs pushed through a lock-free queue, so
+// triggering a sound from the game loop never touches the multimedia pipeline
+// or takes a lock.
+// Public functions are called from the GUI thread only.
+class AudioMixer : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int MAX_VOICES = 16;
+    static constexpr int PART_MS    = 2000;
+
+    enum class Mode : quint8 {
+        Overlap, // always a new voice
+        Restart, // replaces the voice holding the same tag
+        Loop     // loops; if the tag is already sounding it keeps going and any fade is cancelled
+    };
+
+    explicit AudioMixer(QObject* parent = nullptr);
+    ~AudioMixer();
+
+    // Queues src for loading and returns its sound id right away. One-shots
+    // played before the sound is loaded are dropped; loops wait for it.
+    int load(const QUrl& src);
+    // True once every load() so far has finished decoding (or failed).
+    bool isReady() const { return m_pending == 0; }
+    // Frees the sound's samples once no voice plays it (a fade-out finishes
+    // first). The id must not be played again.
+    void unload(int sound);
+
+    // Tag 0 is anonymous; Restart and Loop need a non-zero tag.
+    void play(int sound, float gain, int tag = 0, Mode mode = Mode::Overlap);
+    // Loops sound on tag. If the tag is playing a different sound, that voice
+    // fades out while the new one fades in over ms; a sound that is still
+    // loading starts its fade-in once it is ready.
+    void crossfadeTo(int sound, float gain, int tag, int ms);
+    // Ramps the tagged voice to silence over ms and then releases it.
+    void fadeOut(int tag, int ms);
+    // Changes the gain of the tagged voice, if it is sounding.
+    void setGain(int tag, float gain);
+
+    struct Command {
+        enum Type : quint8 { Play, Fade, Gain, Part, Loaded, LoadFailed, Unload } type = Play;
+        Mode  mode  = Mode::Overlap;
+        qint16 tag  = 0;
+        qint32 sound = -1;
+        float gain  = 1.0f;
+        qint32 fadeMs = 0;
+        QVector<qint16>* part = nullptr; // Part only; the mixer takes ownership
+    };
+
+signals:
+    // Emitted whenever the last outstanding load() finishes.
+    void ready();
+
+private:
+    void cacheLookedUp(int id, const QUrl& src, const QString& key, const PcmCache::Mapped& mapped);
+    void decode(int id, const QUrl& src);
+    void partDecoded(int id, const QVector<qint16>& part);
+    void decodeFinished(int id, bool ok);
+    void loadFinished();
+    void submit(const Command& c);
+    void submitLoad(const Command& c);
+    void flushLoadBacklog();
+
+    QAudioFormat m_format;
+    QThreadPool m_io;               // cache lookups and writes, off both the GUI and the mixer thread
+    QThread m_decodeThread;
+    QObject* m_decodeContext = nullptr; // lives on m_decodeThread and owns the decoders
+    QHash<int, QString> m_cacheKeys;
+    QHash<int, QVector<QVector<qint16>>> m_decodedParts; // kept for the cache file
+    QVector<Command> m_loadBacklog;
+    QTimer m_backlogTimer;
+    QThread m_thread;
+    MixerEngine* m_engine = nullptr;
+    SpscQueue<Command, 256> m_commands;
+    int m_nextSound = 0;
+    int m_pending = 0;
+};
+
+#endif // AUDIOMIXER_H
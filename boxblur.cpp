@@ -0,0 +1,97 @@
+// boxblur.cpp
+#include "boxblur.h"
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+void BoxBlur::apply(QImage& img, int radius) {
+    const int r = std::min(radius, int(MAX_RADIUS));
+    if (r <= 0 || img.isNull() || img.depth() != 32) return;
+
+    const int n = 2 * r + 1;
+    const quint16 mul = quint16((65536 + n - 1) / n);
+
+    if (m_tmp.size() != img.size() || m_tmp.format() != img.format())
+        m_tmp = QImage(img.size(), img.format());
+
+    const int w = img.width();
+    for (int y = 0; y < img.height(); ++y) {
+        horizontal(reinterpret_cast<const quint32*>(img.constScanLine(y)),
+                   reinterpret_cast<quint32*>(m_tmp.scanLine(y)), w, r, mul);
+    }
+    vertical(m_tmp, img, r, mul);
+}
+
+void BoxBlur::horizontal(const quint32* src, quint32* dst, int w, int r, quint16 mul) const {
+    auto at = [&](int x) { return src[std::clamp(x, 0, w - 1)]; };
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i m    = _mm_set1_epi16(short(mul));
+    auto load = [&](int x) { return _mm_unpacklo_epi8(_mm_cvtsi32_si128(int(at(x))), zero); };
+
+    __m128i sum = zero;
+    for (int i = -r; i <= r; ++i) sum = _mm_add_epi16(sum, load(i));
+    for (int x = 0; x < w; ++x) {
+        const __m128i q = _mm_mulhi_epu16(sum, m);
+        dst[x] = quint32(_mm_cvtsi128_si32(_mm_packus_epi16(q, q)));
+        sum = _mm_sub_epi16(_mm_add_epi16(sum, load(x + r + 1)), load(x - r));
+    }
+#else
+    quint32 sum[4] = {0, 0, 0, 0};
+    auto add = [&](quint32 px, int sign) {
+        for (int c = 0; c < 4; ++c) sum[c] += quint32(sign * int((px >> (8 * c)) & 0xFF));
+    };
+    for (int i = -r; i <= r; ++i) add(at(i), 1);
+    for (int x = 0; x < w; ++x) {
+        quint32 out = 0;
+        for (int c = 0; c < 4; ++c) out |= ((sum[c] * mul) >> 16) << (8 * c);
+        dst[x] = out;
+        add(at(x + r + 1), 1);
+        add(at(x - r), -1);
+    }
+#endif
+}
+
+void BoxBlur::vertical(const QImage& src, QImage& dst, int r, quint16 mul) {
+    const int h = src.height();
+    const int bytes = src.width() * 4;
+    auto row = [&](int y) { return src.constScanLine(std::clamp(y, 0, h - 1)); };
+
+    m_acc.fill(0, bytes);
+    quint16* acc = m_acc.data();
+    for (int i = -r; i <= r; ++i) {
+        const uchar* s = row(i);
+        for (int b = 0; b < bytes; ++b) acc[b] += s[b];
+    }
+
+    for (int y = 0; y < h; ++y) {
+        uchar* out = dst.scanLine(y);
+        const uchar* in    = row(y + r + 1);
+        const uchar* leave = row(y - r);
+        int b = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i m    = _mm_set1_epi16(short(mul));
+        for (; b + 16 <= bytes; b += 16) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + b));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + b + 8));
+            const __m128i res = _mm_packus_epi16(_mm_mulhi_epu16(lo, m), _mm_mulhi_epu16(hi, m));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + b), res);
+
+            const __m128i vin = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + b));
+            const __m128i vlv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(leave + b));
+            lo = _mm_sub_epi16(_mm_add_epi16(lo, _mm_unpacklo_epi8(vin, zero)), _mm_unpacklo_epi8(vlv, zero));
+            hi = _mm_sub_epi16(_mm_add_epi16(hi, _mm_unpackhi_epi8(vin, zero)), _mm_unpackhi_epi8(vlv, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + b), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + b + 8), hi);
+        }
+#endif
+        for (; b < bytes; ++b) {
+            out[b] = uchar((quint32(acc[b]) * mul) >> 16);
+            acc[b] = quint16(acc[b] + in[b] - leave[b]);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// boxblur.h
+#ifndef BOXBLUR_H
+#define BOXBLUR_H
+
+#include <QImage>
+#include <QVector>
+#include <QtGlobal>
+
+// Separable integer box blur for 32-bit (A)RGB images, applied in place.
+// A horizontal then a vertical running-sum pass averages each channel over a
+// (2r+1) x (2r+1) window with edge pixels repeated. Division is a 16-bit
+// reciprocal multiply that is exact for every radius up to MAX_RADIUS, so the
+// SSE2 and scalar paths give identical results. Scratch buffers are kept
+// between calls, so blurring a same-sized image every frame does not allocate.
+class BoxBlur {
+public:
+    static constexpr int MAX_RADIUS = 7;
+
+    void apply(QImage& img, int radius);
+
+private:
+    void horizontal(const quint32* src, quint32* dst, int w, int r, quint16 mul) const;
+    void vertical(const QImage& src, QImage& dst, int r, quint16 mul);
+
+    QImage m_tmp;
+    QVector<quint16> m_acc;
+};
+
+#endif // BOXBLUR_H
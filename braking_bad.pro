@@ -1,8 +1,15 @@
 # driver.pro
 
-QT       += core gui widgets multimedia
+QT       += core gui widgets multimedia network
 CONFIG   += c++17
 
+# Per-phase frame probes for the F3 overlay and the trace recorder (trace.h):
+# on in debug builds, and in release with `qmake CONFIG+=perf_probes`.
+CONFIG(debug, debug|release)|perf_probes: DEFINES += BB_PERF_PROBES
+
+# The terrain row kernel uses AVX2 or SSE4.1 when the compiler targets them,
+# e.g. QMAKE_CXXFLAGS += -mavx2; otherwise it falls back to a scalar loop.
+
 TARGET = driver
 TEMPLATE = app
 
@@ -24,7 +31,28 @@ HEADERS += \
     prop.h \
     wheel.h \
     line.h \
-    scoreboard.h
+    scoreboard.h \
+    starfield.h \
+    polyfill.h \
+    carsprite.h \
+    hudtext.h \
+    framebands.h \
+    terrainmaterial.h \
+    terrainkernel.h \
+    stagepaths.h \
+    pixelfont.h \
+    boxblur.h \
+    circlespans.h \
+    spscqueue.h \
+    audiomixer.h \
+    startuptrace.h \
+    pcmcache.h \
+    profilestore.h \
+    runlog.h \
+    leaderboardsync.h \
+    telemetry.h \
+    perfprobe.h \
+    trace.h
 
 # List all source files here
 SOURCES += \
@@ -44,7 +72,27 @@ SOURCES += \
     prop.cpp \
     wheel.cpp \
     line.cpp \
-    scoreboard.cpp
+    scoreboard.cpp \
+    starfield.cpp \
+    polyfill.cpp \
+    carsprite.cpp \
+    hudtext.cpp \
+    framebands.cpp \
+    terrainmaterial.cpp \
+    terrainkernel.cpp \
+    stagepaths.cpp \
+    pixelfont.cpp \
+    boxblur.cpp \
+    circlespans.cpp \
+    audiomixer.cpp \
+    startuptrace.cpp \
+    pcmcache.cpp \
+    profilestore.cpp \
+    runlog.cpp \
+    leaderboardsync.cpp \
+    telemetry.cpp \
+    perfprobe.cpp \
+    trace.cpp
 
 FORMS += \
     mainwindow.ui
@@ -128,6 +128,7 @@ void CarBody::move(int dx, int dy, double angle) {
     for (Point& killSwitch : m_killSwitches) {
         killSwitch.coords = Point::rotate(killSwitch.coords, angleDelta);
     }
+    m_shapeAngle += angleDelta;
     m_angle = angle;
 }
 
@@ -147,9 +148,14 @@ void CarBody::rotate(double angle) {
     for (Point& killSwitch : m_killSwitches) {
         killSwitch.coords = Point::rotate(killSwitch.coords, angleDelta);
     }
+    m_shapeAngle += angleDelta;
     m_angle = angle;
 }
 
+double CarBody::getShapeAngle() const {
+    return m_shapeAngle;
+}
+
 void CarBody::addWheel(Wheel* wheel) {
     m_wheels.append(wheel);
 }
@@ -175,21 +181,34 @@ void CarBody::attach(Wheel* wheel) {
     m_attachDistances.append(dist);
 }
 
-QVector<Line> CarBody::getLines() {
-    QVector<Line> lines;
-    if (m_points.isEmpty()) return lines;
+void CarBody::updateOutline() {
+    m_outline.resize(m_points.size());
+    if (m_points.isEmpty()) { m_outlineBounds = QRect(); return; }
 
-    lines.reserve(m_points.size());
+    auto center = Point(m_cx, m_cy).get(0, 0, 0);
+    int minX = INT_MAX, minY = INT_MAX;
+    int maxX = INT_MIN, maxY = INT_MIN;
     for (int i = 0; i < m_points.size(); i++) {
-        std::array<int, 2> p1 = m_points.at((i + 1) % m_points.size()).get(static_cast<int>(std::round(m_cx)), static_cast<int>(std::round(m_cy)), m_angle);
-        std::array<int, 2> p2 = m_points.at(i).get(static_cast<int>(std::round(m_cx)), static_cast<int>(std::round(m_cy)), m_angle);
-        lines.append(Line(p1[0], p1[1], p2[0], p2[1]));
+        const Point& point = m_points.at(i);
+        const QPoint q(point.coords[0] + center[0], point.coords[1] + center[1]);
+        m_outline[i] = q;
+        minX = std::min(minX, q.x()); maxX = std::max(maxX, q.x());
+        minY = std::min(minY, q.y()); maxY = std::max(maxY, q.y());
     }
-    return lines;
+    m_outlineBounds = QRect(QPoint(minX, minY), QPoint(maxX, maxY));
 }
 
-void CarBody::simulate(int level_index, const QVector<Line>& terrain, bool accelerating, bool braking) {
-    const auto& level = Constants::LEVELS[level_index];
+const QVector<QPoint>& CarBody::outline() const {
+    return m_outline;
+}
+
+const QRect& CarBody::outlineBounds() const {
+    return m_outlineBounds;
+}
+
+template <int Level>
+void CarBody::simulate(const QVector<Line>& terrain, bool accelerating, bool braking) {
+    constexpr const LevelPhysics& level = Constants::LEVEL_PHYSICS[Level];
 
     if (m_isAlive && m_wheels.size() >= 2) {
         double theta = std::atan2(m_wheels[1]->getY() - m_wheels[0]->getY(), m_wheels[1]->getX() - m_wheels[0]->getX());
@@ -366,3 +385,11 @@ QVector<QPoint> CarBody::getKillSwitches(int dx, int dy) const {
     }
     return out;
 }
+
+static_assert(Constants::LEVEL_COUNT == 6, "instantiate CarBody::simulate for every biome");
+template void CarBody::simulate<0>(const QVector<Line>&, bool, bool);
+template void CarBody::simulate<1>(const QVector<Line>&, bool, bool);
+template void CarBody::simulate<2>(const QVector<Line>&, bool, bool);
+template void CarBody::simulate<3>(const QVector<Line>&, bool, bool);
+template void CarBody::simulate<4>(const QVector<Line>&, bool, bool);
+template void CarBody::simulate<5>(const QVector<Line>&, bool, bool);
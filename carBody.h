@@ -6,6 +6,7 @@
 #include <QPair>
 #include <QColor>
 #include <QPoint>
+#include <QRect>
 
 #include "point.h"
 #include "wheel.h"
@@ -35,14 +36,25 @@ public:
     void move(int dx, int dy, double angle);
     void rotate(double angle);
 
+    // Orientation the outline and attachments are actually drawn at. Unlike
+    // m_angle it is not nudged by crash torque.
+    double getShapeAngle() const;
+
     void addWheel(Wheel* wheel);
 
     void kill();
     bool isAlive() const;
 
-    QVector<Line> getLines();
+    // World-space outline (the same points get(0, 0) returns) and its bounding
+    // box. Refreshed by updateOutline() once per tick into storage that is
+    // reused between ticks, so per-frame collision queries do not allocate.
+    void updateOutline();
+    const QVector<QPoint>& outline() const;
+    const QRect& outlineBounds() const;
 
-    void simulate(int, const QVector<Line>& terrain, bool accelerating, bool braking);
+    // Instantiated once per biome (see stagepaths.h)
+    template <int Level>
+    void simulate(const QVector<Line>& terrain, bool accelerating, bool braking);
 
     QVector<QPoint> getKillSwitches(int dx, int dy) const;
 
@@ -56,6 +68,7 @@ private:
     double m_cx = 0.0;
     double m_cy = 0.0;
     double m_angle = 0.0;
+    double m_shapeAngle = 0.0;
     double m_vx = 0.0;
     double m_vy = 0.0;
 
@@ -67,6 +80,9 @@ private:
     QVector<QPair<QVector<Point>, QColor>> m_attachments;
 
     QVector<Point> m_killSwitches;
+
+    QVector<QPoint> m_outline;
+    QRect m_outlineBounds;
     bool m_isAlive = true;
 };
 
@@ -0,0 +1,104 @@
+// carsprite.cpp
+#include "carsprite.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+CarSpriteCache::CarSpriteCache(int buckets, int cellSize)
+    : m_cellSize(cellSize),
+    m_sprites(std::max(1, buckets)),
+    m_built(std::max(1, buckets), false)
+{
+}
+
+void CarSpriteCache::setShape(const QVector<QPoint>& body, const QColor& bodyColor,
+                              const QVector<QPair<QVector<QPoint>, QColor>>& attachments)
+{
+    int xmin = INT_MAX, ymin = INT_MAX;
+    int xmax = INT_MIN, ymax = INT_MIN;
+    for (const QPoint& p : body) {
+        xmin = std::min(xmin, p.x()); xmax = std::max(xmax, p.x());
+        ymin = std::min(ymin, p.y()); ymax = std::max(ymax, p.y());
+    }
+    const double cx = (xmin + xmax) / 2.0;
+    const double cy = (ymin + ymax) / 2.0;
+
+    double radius = 0.0;
+    auto addShape = [&](const QVector<QPoint>& pts, const QColor& color) {
+        Shape s;
+        s.color = color;
+        s.points.reserve(pts.size());
+        for (const QPoint& p : pts) {
+            const QPointF local(p.x() - cx, p.y() - cy);
+            radius = std::max(radius, std::hypot(local.x(), local.y()));
+            s.points.append(local);
+        }
+        m_shapes.append(s);
+    };
+
+    m_shapes.clear();
+    addShape(body, bodyColor);
+    for (const auto& a : attachments) addShape(a.first, a.second);
+
+    m_marginCells = int(std::ceil(radius / m_cellSize)) + 1;
+    std::fill(m_built.begin(), m_built.end(), false);
+    for (Sprite& s : m_sprites) s = Sprite();
+    m_nextWarm = 0;
+}
+
+int CarSpriteCache::bucketFor(double angle) const {
+    const int n = int(m_sprites.size());
+    const double turns = angle / (2.0 * M_PI);
+    int b = int(std::lround((turns - std::floor(turns)) * n));
+    return b % n;
+}
+
+const CarSpriteCache::Sprite& CarSpriteCache::sprite(double angle) {
+    const int b = bucketFor(angle);
+    if (!m_built[b]) build(b);
+    return m_sprites[b];
+}
+
+bool CarSpriteCache::prewarm(int budget) {
+    const int n = int(m_sprites.size());
+    while (m_nextWarm < n && budget > 0) {
+        if (!m_built[m_nextWarm]) { build(m_nextWarm); --budget; }
+        ++m_nextWarm;
+    }
+    return m_nextWarm >= n;
+}
+
+void CarSpriteCache::build(int bucket) {
+    const double angle = 2.0 * M_PI * bucket / double(m_sprites.size());
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+
+    // Shift everything by a whole number of cells so the coordinates handed to
+    // the filler are positive and integer division floors like the grid does.
+    const int side  = 2 * m_marginCells + 1;
+    const int shift = m_marginCells * m_cellSize;
+
+    Sprite& out = m_sprites[bucket];
+    out.image = QImage(side, side, QImage::Format_ARGB32_Premultiplied);
+    out.image.fill(Qt::transparent);
+    out.originCellX = -m_marginCells;
+    out.originCellY = -m_marginCells;
+
+    for (const Shape& shape : m_shapes) {
+        m_scratch.resize(shape.points.size());
+        for (int i = 0; i < shape.points.size(); ++i) {
+            const QPointF& p = shape.points[i];
+            m_scratch[i] = QPoint(int(std::lround(p.x() * c - p.y() * s)) + shift,
+                                  int(std::lround(p.x() * s + p.y() * c)) + shift);
+        }
+        const QRgb px = shape.color.rgba();
+        m_filler.fill(m_scratch.constData(), int(m_scratch.size()), m_cellSize, [&](int y, int x0, int x1) {
+            if (y < 0 || y >= side) return;
+            x0 = std::max(x0, 0);
+            x1 = std::min(x1, side - 1);
+            QRgb* line = reinterpret_cast<QRgb*>(out.image.scanLine(y));
+            std::fill(line + x0, line + x1 + 1, px);
+        });
+    }
+    m_built[bucket] = true;
+}
@@ -0,0 +1,61 @@
+// carsprite.h
+#ifndef CARSPRITE_H
+#define CARSPRITE_H
+
+#include <QColor>
+#include <QImage>
+#include <QPair>
+#include <QPoint>
+#include <QPointF>
+#include <QVector>
+
+#include "polyfill.h"
+
+// Grid-resolution images of the car body and its attachments, one per angle
+// bucket. The shape is rigid, so a rotated sprite only depends on the angle and
+// can be rasterized once and blitted every frame afterwards. Wheels are not part
+// of the sprite because the suspension moves them relative to the body.
+class CarSpriteCache {
+public:
+    struct Sprite {
+        QImage image;         // one texel per grid cell, transparent outside the car
+        int originCellX = 0;  // top-left cell relative to the body centre's cell
+        int originCellY = 0;
+    };
+
+    CarSpriteCache(int buckets, int cellSize);
+
+    // Shape in the same coordinates CarBody::addPoints/addAttachment receive;
+    // it is centred the way CarBody::finish() centres it. Drops every sprite.
+    void setShape(const QVector<QPoint>& body, const QColor& bodyColor,
+                  const QVector<QPair<QVector<QPoint>, QColor>>& attachments);
+
+    int bucketCount() const { return int(m_sprites.size()); }
+    int bucketFor(double angle) const;
+
+    // Builds the bucket on first use.
+    const Sprite& sprite(double angle);
+
+    // Builds up to `budget` missing buckets; returns true once all are built.
+    bool prewarm(int budget);
+
+private:
+    struct Shape {
+        QVector<QPointF> points;
+        QColor color;
+    };
+
+    void build(int bucket);
+
+    int m_cellSize;
+    QVector<Shape> m_shapes;
+    QVector<Sprite> m_sprites;
+    QVector<bool> m_built;
+    int m_nextWarm = 0;
+    int m_marginCells = 0;
+
+    PolygonFiller m_filler;
+    QVector<QPoint> m_scratch;
+};
+
+#endif // CARSPRITE_H
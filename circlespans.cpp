@@ -0,0 +1,67 @@
+// circlespans.cpp
+#include "circlespans.h"
+#include "constants.h"
+#include <QPainter>
+#include <algorithm>
+#include <map>
+
+const QVector<int>& CircleSpans::halfWidths(int radius) {
+    // Node-based so references handed out stay valid as radii are added.
+    static std::map<int, QVector<int>> tables;
+    QVector<int>& hw = tables[radius];
+    if (hw.isEmpty()) {
+        hw.fill(-1, 2 * radius + 1);
+        auto span = [&](int row, int half) { hw[row + radius] = std::max(hw[row + radius], half); };
+        int x = 0;
+        int y = radius;
+        int d = 1 - radius;
+        while (y >= x) {
+            span( y, x);
+            span(-y, x);
+            span( x, y);
+            span(-x, y);
+            ++x;
+            if (d < 0) d += 2 * x + 1;
+            else { --y; d += 2 * (x - y) + 1; }
+        }
+    }
+    return hw;
+}
+
+void CircleSpans::drawRings(QPainter& p, int gcx, int gcy, const CircleRing* rings, int count,
+                            const QRect& clipCells) {
+    const int ps = Constants::PIXEL_SIZE;
+    const bool clip = clipCells.isValid();
+
+    auto fill = [&](int gy, int x0, int x1, const QColor& c) {
+        if (clip) {
+            if (gy < clipCells.top() || gy > clipCells.bottom()) return;
+            x0 = std::max(x0, clipCells.left());
+            x1 = std::min(x1, clipCells.right());
+        }
+        if (x0 <= x1) p.fillRect(x0 * ps, gy * ps, (x1 - x0 + 1) * ps, ps, c);
+    };
+
+    int maxR = -1;
+    for (int i = 0; i < count; ++i) maxR = std::max(maxR, rings[i].radius);
+
+    for (int dy = -maxR; dy <= maxR; ++dy) {
+        // Walk from the last-painted ring outwards; cells it already owns are
+        // skipped, so each ring only fills what shows of it. Every span is
+        // centred on gcx, which keeps the owned cells one centred run.
+        int covered = -1;
+        for (int i = count - 1; i >= 0; --i) {
+            const int r = rings[i].radius;
+            if (r < 0 || dy < -r || dy > r) continue;
+            const int h = halfWidths(r)[dy + r];
+            if (h <= covered) continue;
+            if (covered < 0) {
+                fill(gcy + dy, gcx - h, gcx + h, rings[i].color);
+            } else {
+                fill(gcy + dy, gcx - h, gcx - covered - 1, rings[i].color);
+                fill(gcy + dy, gcx + covered + 1, gcx + h, rings[i].color);
+            }
+            covered = h;
+        }
+    }
+}
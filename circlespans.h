@@ -0,0 +1,37 @@
+// circlespans.h
+#ifndef CIRCLESPANS_H
+#define CIRCLESPANS_H
+
+#include <QColor>
+#include <QRect>
+#include <QVector>
+#include <initializer_list>
+
+class QPainter;
+
+struct CircleRing {
+    int    radius;   // in grid cells; negative rings are skipped
+    QColor color;
+};
+
+// Filled midpoint circles on the pixel grid, from span tables built once per
+// radius. A table holds the half-width of every row, i.e. the union of the
+// midpoint algorithm's eight-way spans. Used from the GUI thread only.
+class CircleSpans {
+public:
+    // Half-widths for rows -radius..radius, indexed by row + radius.
+    static const QVector<int>& halfWidths(int radius);
+
+    // Concentric filled circles listed in painting order (outer rim first). The
+    // result matches painting each circle over the previous one, but every cell
+    // is filled once, in its final colour, as one fillRect per run. Cells
+    // outside clipCells are dropped when it is valid.
+    static void drawRings(QPainter& p, int gcx, int gcy, const CircleRing* rings, int count,
+                          const QRect& clipCells = QRect());
+    static void drawRings(QPainter& p, int gcx, int gcy, std::initializer_list<CircleRing> rings,
+                          const QRect& clipCells = QRect()) {
+        drawRings(p, gcx, gcy, rings.begin(), int(rings.size()), clipCells);
+    }
+};
+
+#endif // CIRCLESPANS_H
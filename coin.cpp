@@ -1,6 +1,9 @@
 #include "coin.h"
+#include "circlespans.h"
+#include "carBody.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 void CoinSystem::maybePlaceCoinStreamAtEdge(
     double elapsedSeconds,
@@ -65,14 +68,18 @@ void CoinSystem::maybePlaceCoinStreamAtEdge(
         c.cx = wx;
         c.cy = gy * Constants::PIXEL_SIZE;
         c.taken = false;
-        coins.append(c);
+        // Streams normally land right of everything placed so far; a car that
+        // stalled or rolled back can make one overlap, so keep the order.
+        auto pos = std::upper_bound(coins.begin(), coins.end(), c.cx,
+                                    [](int x, const Coin& o) { return x < o.cx; });
+        coins.insert(pos, c);
     }
 
     lastPlacedCoinX   = endX;
     lastSpawnTimeSec  = elapsedSeconds;
 }
 
-void CoinSystem::drawWorldCoins(QPainter& p, int cameraX, int cameraY, int /*gridW*/, int /*gridH*/) const {
+void CoinSystem::drawWorldCoins(QPainter& p, int cameraX, int cameraY, int gridW, int /*gridH*/) const {
     const int camGX = cameraX / Constants::PIXEL_SIZE;
     const int camGY = cameraY / Constants::PIXEL_SIZE;
 
@@ -88,63 +95,105 @@ void CoinSystem::drawWorldCoins(QPainter& p, int cameraX, int cameraY, int /*gri
                    Constants::PIXEL_SIZE, c);
     };
 
-    auto drawCircleFilledMidpointGrid = [&](int gcx, int gcy, int gr, const QColor& color) {
-        auto span = [&](int cy, int xl, int xr) {
-            for (int xg = xl; xg <= xr; ++xg) {
-                plotGridPixel(xg, cy, color);
-            }
-        };
-        int x = 0;
-        int y = gr;
-        int d = 1 - gr;
-        while (y >= x) {
-            span(gcy + y, gcx - x, gcx + x);
-            span(gcy - y, gcx - x, gcx + x);
-            span(gcy + x, gcx - y, gcx + y);
-            span(gcy - x, gcx - y, gcx + y);
-            ++x;
-            if (d < 0) {
-                d += 2 * x + 1;
-            } else {
-                --y;
-                d += 2 * (x - y) + 1;
-            }
-        }
-    };
-
-    for (const Coin& c : coins) {
+    const int marginPx = (Constants::COIN_RADIUS_CELLS + 2) * Constants::PIXEL_SIZE;
+    const auto [first, last] = window(cameraX - marginPx, cameraX + gridW * Constants::PIXEL_SIZE + marginPx);
+    for (qsizetype i = first; i < last; ++i) {
+        const Coin& c = coins[i];
         if (c.taken) continue;
 
         int scx = (c.cx / Constants::PIXEL_SIZE) - camGX;
         int scy = (c.cy / Constants::PIXEL_SIZE) + camGY;
         int r   = Constants::COIN_RADIUS_CELLS;
 
-        drawCircleFilledMidpointGrid(scx, scy, r,   rim);
-        if (r-1 > 0) {
-            drawCircleFilledMidpointGrid(scx, scy, r-1, fill);
-        }
-        if (r-2 > 0) {
-            drawCircleFilledMidpointGrid(scx, scy, r-2, fill2);
-        }
+        const CircleRing rings[] = {{r, rim}, {r-1, fill}, {r-2, fill2}};
+        CircleSpans::drawRings(p, scx, scy, rings, 1 + (r-1 > 0) + (r-2 > 0));
 
         plotGridPixel(scx-1, scy-r+1, shine);
         plotGridPixel(scx,   scy-r+1, shine);
     }
 }
 
-void CoinSystem::handlePickups(const QList<Wheel*>& wheels, int& coinCount) {
-    if (wheels.isEmpty()) return;
+static double pointSegDist2(double px, double py, const QPoint& a, const QPoint& b) {
+    const double vx = b.x() - a.x(), vy = b.y() - a.y();
+    const double wx = px - a.x(),    wy = py - a.y();
+    const double len2 = vx*vx + vy*vy;
+    double t = (len2 > 0.0) ? (wx*vx + wy*vy) / len2 : 0.0;
+    t = std::clamp(t, 0.0, 1.0);
+    const double dx = px - (a.x() + t*vx);
+    const double dy = py - (a.y() + t*vy);
+    return dx*dx + dy*dy;
+}
 
-    for (Coin& c : coins) {
-        if (c.taken) continue;
-        double minD2 = 1e18;
-        for (const Wheel* w : wheels) {
-            const double dx = w->x - c.cx;
-            const double dy = w->y - c.cy;
-            const double d2 = dx*dx + dy*dy;
-            if (d2 < minD2) minD2 = d2;
+// Odd-even crossing test, as QPolygon::containsPoint(..., Qt::OddEvenFill).
+static bool insideOddEven(const QVector<QPoint>& poly, int px, int py) {
+    bool inside = false;
+    for (qsizetype i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+        const QPoint& a = poly[i];
+        const QPoint& b = poly[j];
+        if ((a.y() > py) != (b.y() > py)
+            && px < a.x() + double(b.x() - a.x()) * (py - a.y()) / double(b.y() - a.y()))
+            inside = !inside;
+    }
+    return inside;
+}
+
+void CoinSystem::handlePickups(const QList<Wheel*>& wheels, const QList<CarBody*>& bodies, int& coinCount) {
+    const double R = Constants::COIN_PICKUP_RADIUS;
+
+    if (!wheels.isEmpty()) {
+        double minX = wheels.first()->x, maxX = minX;
+        for (const Wheel* w : wheels) { minX = std::min(minX, w->x); maxX = std::max(maxX, w->x); }
+
+        const auto [first, last] = window(int(std::floor(minX - R)), int(std::ceil(maxX + R)));
+        for (qsizetype i = first; i < last; ++i) {
+            Coin& c = coins[i];
+            if (c.taken) continue;
+            double minD2 = 1e18;
+            for (const Wheel* w : wheels) {
+                const double dx = w->x - c.cx;
+                const double dy = w->y - c.cy;
+                const double d2 = dx*dx + dy*dy;
+                if (d2 < minD2) minD2 = d2;
+            }
+            if (minD2 <= R*R) { c.taken = true; ++coinCount; }
         }
-        const double R = Constants::COIN_PICKUP_RADIUS;
-        if (minD2 <= R*R) { c.taken = true; ++coinCount; }
     }
+
+    for (const CarBody* body : bodies) {
+        const QVector<QPoint>& outline = body->outline();
+        if (outline.isEmpty()) continue;
+
+        // Anything outside the outline's box grown by the pickup radius can
+        // neither touch an edge nor be inside; only the rest get the exact test.
+        const QRect reach = body->outlineBounds().adjusted(-Constants::COIN_PICKUP_RADIUS, -Constants::COIN_PICKUP_RADIUS,
+                                                           Constants::COIN_PICKUP_RADIUS, Constants::COIN_PICKUP_RADIUS);
+        const auto [first, last] = window(reach.left(), reach.right());
+        for (qsizetype i = first; i < last; ++i) {
+            Coin& c = coins[i];
+            if (c.taken || c.cy < reach.top() || c.cy > reach.bottom()) continue;
+
+            bool hit = false;
+            for (qsizetype e = 0; e < outline.size() && !hit; ++e) {
+                const QPoint& a = outline[e];
+                const QPoint& b = outline[(e + 1) % outline.size()];
+                hit = pointSegDist2(c.cx, c.cy, a, b) <= R*R;
+            }
+            if (!hit) hit = insideOddEven(outline, c.cx, c.cy);
+
+            if (hit) { c.taken = true; ++coinCount; }
+        }
+    }
+}
+
+std::pair<qsizetype, qsizetype> CoinSystem::window(int x0, int x1) const {
+    auto lo = std::lower_bound(coins.cbegin(), coins.cend(), x0,
+                               [](const Coin& c, int x) { return c.cx < x; });
+    auto hi = std::upper_bound(lo, coins.cend(), x1,
+                               [](int x, const Coin& c) { return x < c.cx; });
+    return {lo - coins.cbegin(), hi - coins.cbegin()};
+}
+
+void CoinSystem::prune(int minX) {
+    const qsizetype n = window(std::numeric_limits<int>::min(), minX - 1).second;
+    if (n > 0) coins.remove(0, n);
 }
@@ -6,9 +6,12 @@
 #include <QPainter>
 #include <QHash>
 #include <random>
+#include <utility>
 #include "constants.h"
 #include "wheel.h"
 
+class CarBody;
+
 struct Coin {
     int cx;
     int cy;
@@ -17,6 +20,7 @@ struct Coin {
 
 class CoinSystem {
 public:
+    // Kept sorted by cx so the per-frame queries can binary-search an x-window.
     QVector<Coin> coins;
     int    lastPlacedCoinX = 0;
     double lastSpawnTimeSec = 0.0;
@@ -33,7 +37,15 @@ public:
 
     void drawWorldCoins(QPainter& p, int cameraX, int cameraY, int gridW, int gridH) const;
 
-    void handlePickups(const QList<Wheel*>& wheels, int& coinCount);
+    // Collects coins within pickup reach of a wheel centre or of a body outline
+    // (edge distance or inside the polygon). Bodies must have had
+    // updateOutline() called this tick.
+    void handlePickups(const QList<Wheel*>& wheels, const QList<CarBody*>& bodies, int& coinCount);
+
+    // Index range [first, second) of the coins with x0 <= cx <= x1.
+    std::pair<qsizetype, qsizetype> window(int x0, int x1) const;
+    // Drops every coin left of minX.
+    void prune(int minX);
 };
 
 #endif // COIN_H
@@ -5,11 +5,15 @@
 #include <QString>
 #include <QPoint>
 #include <QVector>
-#include <QHash>
 #include <array>
+#include <string_view>
 
+// Plain literal data so the whole level table is built at compile time.
 struct LevelData {
-    QString name;
+    static constexpr int PALETTE_SIZE = 10;
+    using Palette = std::array<QColor, PALETTE_SIZE>;
+
+    std::string_view name;
     int cost;
 
     // Physics
@@ -37,8 +41,22 @@ struct LevelData {
     QColor flipPopupColor;
 
     // Palettes
-    QVector<QColor> grassPalette;
-    QVector<QColor> dirtPalette;
+    Palette grassPalette;
+    Palette dirtPalette;
+
+    QString displayName() const { return QString::fromLatin1(name.data(), qsizetype(name.size())); }
+};
+
+struct LevelPhysics {
+    double gravity;
+    double airResistance;
+    double restitution;
+    double friction;
+    double traction;
+};
+
+struct LevelRender {
+    bool highway;
 };
 
 struct Constants {
@@ -76,6 +94,14 @@ struct Constants {
     static constexpr QColor CAR_GLASS_COLOR  = QColor(20,20,20);
     static constexpr QColor CAR_HANDLE_COLOR = QColor(40,40,40);
 
+    // Rotated body sprites; 0 rasterizes the outline every frame instead.
+    static constexpr int  CAR_SPRITE_BUCKETS = 256;
+    static constexpr bool CAR_SPRITE_PREWARM = true;
+
+    // Threads used to render the world frame; 0 uses every core.
+    // The BB_RENDER_THREADS environment variable overrides it.
+    static constexpr int RENDER_THREADS = 0;
+
     // CAR SHAPE DEFINITIONS
     inline static const QVector<QPoint> CAR_BODY_POINTS = {
         QPoint(0,0), QPoint(0,31), QPoint(9,37), QPoint(15,19), QPoint(44,19),
@@ -148,12 +174,32 @@ static constexpr int SCORE_PER_NITRO = 25;
 static constexpr QColor INTRO_COIN_COLOR = QColor(254, 194, 12);
 
 
-inline static const QVector<LevelData> LEVELS = {
+// Per-biome values the physics step and terrain shader are specialized on.
+// LEVELS reads its physics columns from here so there is one source of truth.
+static constexpr int LEVEL_COUNT = 6;
+
+static constexpr std::array<LevelPhysics, LEVEL_COUNT> LEVEL_PHYSICS = {{
+    // Gravity, Air, Rest, Fric, Trac
+    {0.08, 0.0005,  0.8,  0.003,  1.0 },  // MEADOW
+    {0.08, 0.0003,  0.5,  0.03,   1.25},  // DESERT
+    {0.08, 0.0007,  0.8,  0.0001, 0.5 },  // TUNDRA
+    {0.04, 0.00001, 0.7,  0.001,  0.5 },  // LUNAR
+    {0.06, 0.00005, 0.07, 0.03,   0.75},  // MARTIAN
+    {0.08, 0.0007,  0.5,  0.005,  1.5 },  // NIGHTLIFE
+}};
+
+static constexpr std::array<LevelRender, LEVEL_COUNT> LEVEL_RENDER = {{
+    {false}, {false}, {false}, {false}, {false},
+    {true},   // NIGHTLIFE: terrain top is a highway
+}};
+
+static constexpr std::array<LevelData, LEVEL_COUNT> LEVELS = {{
     // LEVEL 0: MEADOW
     {
         "MEADOW", 0,
         // Physics: Gravity, Air, Rest, Fric, Trac
-        0.08, 0.0005, 0.8, 0.003, 1.0,
+        LEVEL_PHYSICS[0].gravity, LEVEL_PHYSICS[0].airResistance, LEVEL_PHYSICS[0].restitution,
+        LEVEL_PHYSICS[0].friction, LEVEL_PHYSICS[0].traction,
         // World: Slope, InitDiff, DiffInc, InitIrreg, IrregInc, InitHeight, HeightInc
         1.0, 0.005, 0.0001, 0.01, 0.00001, 10, 0.001,
         // Visuals: CloudProb, StarProb, Sky, Cloud, Text, Flip
@@ -168,7 +214,8 @@ inline static const QVector<LevelData> LEVELS = {
     // LEVEL 1: DESERT
     {
         "DESERT", 300,
-        0.08, 0.0003, 0.5, 0.03, 1.25,
+        LEVEL_PHYSICS[1].gravity, LEVEL_PHYSICS[1].airResistance, LEVEL_PHYSICS[1].restitution,
+        LEVEL_PHYSICS[1].friction, LEVEL_PHYSICS[1].traction,
         1.5, 0.005, 0.0002, 0.001, 0.000001, 10, 0.002,
         0.1, 0.0, QColor(255,220,200), QColor(255,255,200), QColor(20,20,20), QColor(0,0,0),
         // Grass (Sand)
@@ -181,7 +228,8 @@ inline static const QVector<LevelData> LEVELS = {
     // LEVEL 2: TUNDRA
     {
         "TUNDRA", 600,
-        0.08, 0.0007, 0.8, 0.0001, 0.5,
+        LEVEL_PHYSICS[2].gravity, LEVEL_PHYSICS[2].airResistance, LEVEL_PHYSICS[2].restitution,
+        LEVEL_PHYSICS[2].friction, LEVEL_PHYSICS[2].traction,
         0.8, 0.008, 0.0001, 0.01, 0.00003, 10, 0.001,
         0.7, 0.0, QColor(210,210,255), QColor(255,255,255), QColor(20,20,20), QColor(0,0,0),
         // Grass (Snow)
@@ -194,7 +242,8 @@ inline static const QVector<LevelData> LEVELS = {
     // LEVEL 3: LUNAR
     {
         "LUNAR", 1000,
-        0.04, 0.00001, 0.7, 0.001, 0.5,
+        LEVEL_PHYSICS[3].gravity, LEVEL_PHYSICS[3].airResistance, LEVEL_PHYSICS[3].restitution,
+        LEVEL_PHYSICS[3].friction, LEVEL_PHYSICS[3].traction,
         2.0, 0.01, 0.0003, 0.05, 0.0001, 20, 0.002,
         0.0, 0.7, QColor(0,0,0), QColor(0,0,0), QColor(200,200,200), QColor(237,181,37),
         // Grass (Moon Dust)
@@ -207,7 +256,8 @@ inline static const QVector<LevelData> LEVELS = {
     // LEVEL 4: MARTIAN
     {
         "MARTIAN", 1500,
-        0.06, 0.00005, 0.07, 0.03, 0.75,
+        LEVEL_PHYSICS[4].gravity, LEVEL_PHYSICS[4].airResistance, LEVEL_PHYSICS[4].restitution,
+        LEVEL_PHYSICS[4].friction, LEVEL_PHYSICS[4].traction,
         1.5, 0.008, 0.0002, 0.02, 0.00005, 10, 0.002,
         0.05, 0.0, QColor(200, 150, 150), QColor(255, 220, 200), QColor(20,20,20), QColor(0,0,0),
         // Grass (Red Rock)
@@ -220,7 +270,8 @@ inline static const QVector<LevelData> LEVELS = {
     // LEVEL 5: NIGHTLIFE
     {
         "NIGHTLIFE", 2500,
-        0.08, 0.0007, 0.5, 0.005, 1.5,
+        LEVEL_PHYSICS[5].gravity, LEVEL_PHYSICS[5].airResistance, LEVEL_PHYSICS[5].restitution,
+        LEVEL_PHYSICS[5].friction, LEVEL_PHYSICS[5].traction,
         0.5, 0.001, 0.0001, 0.05, 0.0001, 5, 0.0005,
         0.0, 0.7, QColor(30, 30, 40), QColor(50, 50, 25), QColor(200, 200, 200), QColor(237,181,37),
         // Grass (Asphalt/Concrete)
@@ -230,53 +281,78 @@ inline static const QVector<LevelData> LEVELS = {
         {QColor(40, 40, 45), QColor(35, 35, 40), QColor(45, 45, 50), QColor(30, 30, 35), QColor(40, 40, 45),
          QColor(35, 35, 40), QColor(45, 45, 50), QColor(40, 40, 45), QColor(35, 35, 40), QColor(30, 30, 35)}
     }
+}};
 };
-};
 
-// Font mapping
-inline const QHash<QChar, std::array<uint8_t,7>> font_map = {
-    {'A',{0x0E,0x11,0x11,0x1F,0x11,0x11,0x11}},
-    {'B',{0x1E,0x11,0x11,0x1E,0x11,0x11,0x1E}},
-    {'C',{0x0E,0x11,0x10,0x10,0x10,0x11,0x0E}},
-    {'D',{0x1E,0x11,0x11,0x11,0x11,0x11,0x1E}},
-    {'E',{0x1F,0x10,0x10,0x1E,0x10,0x10,0x1F}},
-    {'F',{0x1F,0x10,0x10,0x1E,0x10,0x10,0x10}},
-    {'G',{0x0E,0x11,0x10,0x10,0x13,0x11,0x0E}},
-    {'H',{0x11,0x11,0x11,0x1F,0x11,0x11,0x11}},
-    {'I',{0x1F,0x04,0x04,0x04,0x04,0x04,0x1F}},
-    {'J',{0x07,0x02,0x02,0x02,0x12,0x12,0x0C}},
-    {'K',{0x11,0x12,0x14,0x18,0x14,0x12,0x11}},
-    {'L',{0x10,0x10,0x10,0x10,0x10,0x10,0x1F}},
-    {'M',{0x11,0x1B,0x15,0x15,0x11,0x11,0x11}},
-    {'m',{0x00,0x00,0x1A,0x15,0x15,0x15,0x15}},
-    {'N',{0x11,0x19,0x15,0x13,0x11,0x11,0x11}},
-    {'O',{0x0E,0x11,0x11,0x11,0x11,0x11,0x0E}},
-    {'P',{0x1E,0x11,0x11,0x1E,0x10,0x10,0x10}},
-    {'Q',{0x0E,0x11,0x11,0x11,0x15,0x12,0x0D}},
-    {'R',{0x1E,0x11,0x11,0x1E,0x14,0x12,0x11}},
-    {'S',{0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E}},
-    {'T',{0x1F,0x04,0x04,0x04,0x04,0x04,0x04}},
-    {'U',{0x11,0x11,0x11,0x11,0x11,0x11,0x0E}},
-    {'V',{0x11,0x11,0x11,0x11,0x11,0x0A,0x04}},
-    {'W',{0x11,0x11,0x11,0x15,0x15,0x1B,0x11}},
-    {'X',{0x11,0x0A,0x04,0x04,0x0A,0x11,0x11}},
-    {'Y',{0x11,0x11,0x0A,0x04,0x04,0x04,0x04}},
-    {'Z',{0x1F,0x01,0x02,0x04,0x08,0x10,0x1F}},
-    {'0',{0x0E,0x11,0x13,0x15,0x19,0x11,0x0E}},
-    {'1',{0x04,0x0C,0x04,0x04,0x04,0x04,0x0E}},
-    {'2',{0x0E,0x11,0x01,0x02,0x04,0x08,0x1F}},
-    {'3',{0x0E,0x11,0x01,0x06,0x01,0x11,0x0E}},
-    {'4',{0x02,0x06,0x0A,0x12,0x1F,0x02,0x02}},
-    {'5',{0x1F,0x10,0x1E,0x01,0x01,0x11,0x0E}},
-    {'6',{0x06,0x08,0x10,0x1E,0x11,0x11,0x0E}},
-    {'7',{0x1F,0x01,0x02,0x04,0x08,0x08,0x08}},
-    {'8',{0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E}},
-    {'9',{0x0E,0x11,0x11,0x0F,0x01,0x02,0x0C}},
-    {':',{0x04,0x04,0x00,0x00,0x04,0x04,0x00}},
-    {' ',{0x00,0x00,0x00,0x00,0x00,0x00,0x00}},
-    {'.',{0x00,0x00,0x00,0x00,0x00,0x04,0x04}},
-    {'<',{0x01,0x03,0x07,0x0F,0x07,0x03,0x01}},
-    {'>',{0x10,0x18,0x1C,0x1E,0x1C,0x18,0x10}}
+// 5x7 bitmap font: seven rows of 5-bit masks, leftmost pixel in bit 4.
+using Glyph = std::array<uint8_t,7>;
+
+// Glyphs indexed directly by ASCII code; lookups are a bounds check and an index.
+struct GlyphTable {
+    std::array<Glyph, 128> rows{};
+    std::array<bool, 128>  defined{};
+
+    constexpr void set(char c, const Glyph& g) { rows[uchar(c)] = g; defined[uchar(c)] = true; }
+
+    // Null when the font has no glyph for ch.
+    constexpr const Glyph* find(QChar ch) const {
+        const char16_t u = ch.unicode();
+        return (u < 128 && defined[u]) ? &rows[u] : nullptr;
+    }
+    // Characters outside the font render as a space.
+    constexpr const Glyph& glyph(QChar ch) const {
+        const Glyph* g = find(ch);
+        return g ? *g : rows[' '];
+    }
 };
 
+constexpr GlyphTable makeFontMap() {
+    GlyphTable t;
+    t.set('A', {0x0E,0x11,0x11,0x1F,0x11,0x11,0x11});
+    t.set('B', {0x1E,0x11,0x11,0x1E,0x11,0x11,0x1E});
+    t.set('C', {0x0E,0x11,0x10,0x10,0x10,0x11,0x0E});
+    t.set('D', {0x1E,0x11,0x11,0x11,0x11,0x11,0x1E});
+    t.set('E', {0x1F,0x10,0x10,0x1E,0x10,0x10,0x1F});
+    t.set('F', {0x1F,0x10,0x10,0x1E,0x10,0x10,0x10});
+    t.set('G', {0x0E,0x11,0x10,0x10,0x13,0x11,0x0E});
+    t.set('H', {0x11,0x11,0x11,0x1F,0x11,0x11,0x11});
+    t.set('I', {0x1F,0x04,0x04,0x04,0x04,0x04,0x1F});
+    t.set('J', {0x07,0x02,0x02,0x02,0x12,0x12,0x0C});
+    t.set('K', {0x11,0x12,0x14,0x18,0x14,0x12,0x11});
+    t.set('L', {0x10,0x10,0x10,0x10,0x10,0x10,0x1F});
+    t.set('M', {0x11,0x1B,0x15,0x15,0x11,0x11,0x11});
+    t.set('m', {0x00,0x00,0x1A,0x15,0x15,0x15,0x15});
+    t.set('N', {0x11,0x19,0x15,0x13,0x11,0x11,0x11});
+    t.set('O', {0x0E,0x11,0x11,0x11,0x11,0x11,0x0E});
+    t.set('P', {0x1E,0x11,0x11,0x1E,0x10,0x10,0x10});
+    t.set('Q', {0x0E,0x11,0x11,0x11,0x15,0x12,0x0D});
+    t.set('R', {0x1E,0x11,0x11,0x1E,0x14,0x12,0x11});
+    t.set('S', {0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E});
+    t.set('T', {0x1F,0x04,0x04,0x04,0x04,0x04,0x04});
+    t.set('U', {0x11,0x11,0x11,0x11,0x11,0x11,0x0E});
+    t.set('V', {0x11,0x11,0x11,0x11,0x11,0x0A,0x04});
+    t.set('W', {0x11,0x11,0x11,0x15,0x15,0x1B,0x11});
+    t.set('X', {0x11,0x0A,0x04,0x04,0x0A,0x11,0x11});
+    t.set('Y', {0x11,0x11,0x0A,0x04,0x04,0x04,0x04});
+    t.set('Z', {0x1F,0x01,0x02,0x04,0x08,0x10,0x1F});
+    t.set('0', {0x0E,0x11,0x13,0x15,0x19,0x11,0x0E});
+    t.set('1', {0x04,0x0C,0x04,0x04,0x04,0x04,0x0E});
+    t.set('2', {0x0E,0x11,0x01,0x02,0x04,0x08,0x1F});
+    t.set('3', {0x0E,0x11,0x01,0x06,0x01,0x11,0x0E});
+    t.set('4', {0x02,0x06,0x0A,0x12,0x1F,0x02,0x02});
+    t.set('5', {0x1F,0x10,0x1E,0x01,0x01,0x11,0x0E});
+    t.set('6', {0x06,0x08,0x10,0x1E,0x11,0x11,0x0E});
+    t.set('7', {0x1F,0x01,0x02,0x04,0x08,0x08,0x08});
+    t.set('8', {0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E});
+    t.set('9', {0x0E,0x11,0x11,0x0F,0x01,0x02,0x0C});
+    t.set(':', {0x04,0x04,0x00,0x00,0x04,0x04,0x00});
+    t.set(' ', {0x00,0x00,0x00,0x00,0x00,0x00,0x00});
+    t.set('.', {0x00,0x00,0x00,0x00,0x00,0x04,0x04});
+    t.set('<', {0x01,0x03,0x07,0x0F,0x07,0x03,0x01});
+    t.set('>', {0x10,0x18,0x1C,0x1E,0x1C,0x18,0x10});
+    return t;
+}
+
+inline constexpr GlyphTable font_map = makeFontMap();
+
 #endif
@@ -1,5 +1,7 @@
 // flip.cpp
 #include "flip.h"
+#include "hudtext.h"
+#include "pixelfont.h"
 #include <QtMath>
 #include <algorithm>
 
@@ -53,39 +55,31 @@ void FlipTracker::drawHUD(QPainter& p, int levelIndex) const
     const int nitroBaselineGY = Constants::HUD_TOP_MARGIN + Constants::COIN_RADIUS_CELLS*2 + 4;
     const int extraGapCells = 10;
     const int textGY = nitroBaselineGY + 7 + extraGapCells;
-    QFont f; f.setFamily("Monospace"); f.setBold(true); f.setPointSize(12);
-    p.setFont(f);
     p.setPen(Constants::LEVELS[levelIndex].textColor);
-    p.drawText(textGX * Constants::PIXEL_SIZE,
-               textGY  * Constants::PIXEL_SIZE,
-               QString("Flips: %1").arg(total()));
+    HudText::draw(p, textGX * Constants::PIXEL_SIZE,
+                  textGY  * Constants::PIXEL_SIZE,
+                  QString("Flips: %1").arg(total()));
 }
 
 
 // === Popup ===
-void FlipTracker::drawPixelWordFlip(QPainter& p, int gx, int gy, int cell, const QColor& c)
+static constexpr GlyphTable makeFlipFont()
 {
-    auto plot=[&](int x,int y){ p.fillRect((gx+x)*cell,(gy+y)*cell,cell,cell,c); };
-    static const uint8_t F[7]={0x1F,0x10,0x1E,0x10,0x10,0x10,0x10};
-    static const uint8_t l[7]={0x04,0x04,0x04,0x04,0x04,0x04,0x06};
-    static const uint8_t i[7]={0x00,0x08,0x00,0x18,0x08,0x08,0x1C};
-    static const uint8_t glyphP[7]={0x00,0x00,0x1C,0x12,0x1C,0x10,0x10};
-    static const uint8_t ex[7]={0x04,0x04,0x04,0x04,0x04,0x00,0x04};
+    GlyphTable t;
+    t.set('F', {0x1F,0x10,0x1E,0x10,0x10,0x10,0x10});
+    t.set('l', {0x04,0x04,0x04,0x04,0x04,0x04,0x06});
+    t.set('i', {0x00,0x08,0x00,0x18,0x08,0x08,0x1C});
+    t.set('p', {0x00,0x00,0x1C,0x12,0x1C,0x10,0x10});
+    t.set('!', {0x04,0x04,0x04,0x04,0x04,0x00,0x04});
+    return t;
+}
 
-    auto drawChar=[&](const uint8_t rows[7], int ox){
-        for(int ry=0; ry<7; ++ry){
-            uint8_t row=rows[ry];
-            for(int rx=0; rx<5; ++rx)
-                if (row & (1<<(4-rx))) plot(ox+rx, ry);
-        }
-    };
+static constexpr GlyphTable FLIP_FONT = makeFlipFont();
 
-    int adv=6;
-    drawChar(F, 0);
-    drawChar(l, adv*1);
-    drawChar(i, adv*2);
-    drawChar(glyphP, adv*3);
-    drawChar(ex,adv*4);
+void FlipTracker::drawPixelWordFlip(QPainter& p, int gx, int gy, int cell, const QColor& c)
+{
+    static PixelFont font(FLIP_FONT, 6, false);
+    font.draw(p, QStringLiteral("Flip!"), gx, gy, cell, 1, c);
 }
 
 void FlipTracker::drawWorldPopups(QPainter& p, int cameraX, int cameraY, int level_index) const
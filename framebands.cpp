@@ -0,0 +1,55 @@
+// framebands.cpp
+#include "framebands.h"
+#include <QThread>
+#include <algorithm>
+
+FrameBands::FrameBands() {
+    setThreadCount(0);
+}
+
+void FrameBands::setThreadCount(int threads) {
+    m_threads = (threads > 0) ? threads : std::max(1, QThread::idealThreadCount());
+    // The caller renders a band too, so the pool only needs the remaining workers.
+    m_pool.setMaxThreadCount(std::max(1, m_threads - 1));
+}
+
+void FrameBands::resize(int widthCells, int heightCells) {
+    widthCells  = std::max(1, widthCells);
+    heightCells = std::max(1, heightCells);
+    if (m_frame.width() == widthCells && m_frame.height() == heightCells) return;
+    m_frame = QImage(widthCells, heightCells, QImage::Format_ARGB32_Premultiplied);
+}
+
+FrameBands::Pixels FrameBands::pixels(QImage& slice, int gy0, int gy1) {
+    Pixels px;
+    px.bits   = reinterpret_cast<QRgb*>(slice.bits());
+    px.stride = slice.bytesPerLine() / qsizetype(sizeof(QRgb));
+    px.width  = slice.width();
+    px.gy0    = gy0;
+    px.gy1    = gy1;
+    return px;
+}
+
+void FrameBands::render(const BandFn& fn) {
+    const int h = m_frame.height();
+    const int w = m_frame.width();
+    const qsizetype bpl = m_frame.bytesPerLine();
+    uchar* base = m_frame.bits(); // detach once here, never from a worker
+
+    // Two bands per thread so a band full of terrain does not leave the other
+    // threads idle while it finishes.
+    const int bands = (m_threads == 1) ? 1 : std::min(h, m_threads * 2);
+    const int rowsPerBand = (h + bands - 1) / bands;
+
+    auto runBand = [=, &fn](int row0, int row1) {
+        QImage slice(base + row0 * bpl, w, row1 - row0, bpl, QImage::Format_ARGB32_Premultiplied);
+        fn(slice, row0, row1);
+    };
+
+    for (int row0 = rowsPerBand; row0 < h; row0 += rowsPerBand) {
+        const int row1 = std::min(h, row0 + rowsPerBand);
+        m_pool.start([=]{ runBand(row0, row1); });
+    }
+    runBand(0, std::min(h, rowsPerBand));
+    m_pool.waitForDone();
+}
@@ -0,0 +1,48 @@
+// framebands.h
+#ifndef FRAMEBANDS_H
+#define FRAMEBANDS_H
+
+#include <QImage>
+#include <QThreadPool>
+#include <functional>
+
+// Grid-resolution frame buffer that is rendered as horizontal bands in parallel.
+// Every band gets a QImage that wraps its own rows of the shared frame (no copy,
+// no locking); the calling thread renders the first band itself and returns once
+// all bands are finished, so the frame can be presented right after render().
+class FrameBands {
+public:
+    // Band callback: `slice` covers frame rows [row0, row1).
+    using BandFn = std::function<void(QImage& slice, int row0, int row1)>;
+
+    // Direct pixel access to a band, addressed by the caller's own row numbers
+    // (row gy0 is the first row of the slice).
+    struct Pixels {
+        QRgb* bits = nullptr;
+        qsizetype stride = 0; // in pixels
+        int width = 0;
+        int gy0 = 0;
+        int gy1 = 0;
+        QRgb* row(int gy) const { return bits + (gy - gy0) * stride; }
+    };
+    static Pixels pixels(QImage& slice, int gy0, int gy1);
+
+    FrameBands();
+
+    // 0 means QThread::idealThreadCount().
+    void setThreadCount(int threads);
+    int threadCount() const { return m_threads; }
+
+    void resize(int widthCells, int heightCells);
+    const QImage& image() const { return m_frame; }
+    QImage& image() { return m_frame; }
+
+    void render(const BandFn& fn);
+
+private:
+    QThreadPool m_pool;
+    QImage m_frame;
+    int m_threads = 1;
+};
+
+#endif // FRAMEBANDS_H
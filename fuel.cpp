@@ -1,6 +1,7 @@
 #include "fuel.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 int FuelSystem::currentFuelSpacing(double difficulty, double elapsedSeconds) const {
     int base    = 700;
@@ -35,12 +36,12 @@ void FuelSystem::maybePlaceFuelAtEdge(
     f.wx = lastTerrainX;
     f.wy = (gyGround - Constants::FUEL_FLOOR_OFFSET_CELLS) * Constants::PIXEL_SIZE;
     f.taken = false;
-    cans.append(f);
+    cans.append(f);   // lastTerrainX only grows, so this keeps cans sorted
 
     lastPlacedFuelX = lastTerrainX;
 }
 
-void FuelSystem::drawWorldFuel(QPainter& p, int cameraX, int cameraY) const {
+void FuelSystem::drawWorldFuel(QPainter& p, int cameraX, int cameraY, int viewWidth) const {
     const int camGX = cameraX / Constants::PIXEL_SIZE;
     const int camGY = cameraY / Constants::PIXEL_SIZE;
 
@@ -56,7 +57,11 @@ void FuelSystem::drawWorldFuel(QPainter& p, int cameraX, int cameraY) const {
                    Constants::PIXEL_SIZE, c);
     };
 
-    for (const FuelCan& f : cans) {
+    // A can is 6 cells wide including its shadow.
+    const auto [first, last] = window(cameraX - 8 * Constants::PIXEL_SIZE,
+                                      cameraX + viewWidth + 2 * Constants::PIXEL_SIZE);
+    for (qsizetype i = first; i < last; ++i) {
+        const FuelCan& f = cans[i];
         if (f.taken) continue;
 
         int sx = (f.wx / Constants::PIXEL_SIZE) - camGX;
@@ -87,7 +92,15 @@ void FuelSystem::drawWorldFuel(QPainter& p, int cameraX, int cameraY) const {
 void FuelSystem::handlePickups(const QList<Wheel*>& wheels, double& fuel) {
     if (wheels.isEmpty()) return;
 
-    for (FuelCan& f : cans) {
+    const double R = Constants::FUEL_PICKUP_RADIUS + 20;
+    double minX = wheels.first()->x, maxX = minX;
+    for (const Wheel* w : wheels) { minX = std::min(minX, w->x); maxX = std::max(maxX, w->x); }
+
+    // Pickup distance is measured from the can's centre, 2 cells right of wx.
+    const int offX = 2 * Constants::PIXEL_SIZE;
+    const auto [first, last] = window(int(std::floor(minX - R)) - offX, int(std::ceil(maxX + R)) - offX);
+    for (qsizetype i = first; i < last; ++i) {
+        FuelCan& f = cans[i];
         if (f.taken) continue;
         const double fx = f.wx + 2 * Constants::PIXEL_SIZE;
         const double fy = f.wy + 3 * Constants::PIXEL_SIZE;
@@ -98,7 +111,19 @@ void FuelSystem::handlePickups(const QList<Wheel*>& wheels, double& fuel) {
             const double d2 = dx*dx + dy*dy;
             if (d2 < minD2) minD2 = d2;
         }
-        const double R = Constants::FUEL_PICKUP_RADIUS + 20;
         if (minD2 <= R*R) { f.taken = true; fuel = Constants::FUEL_MAX; }
     }
 }
+
+std::pair<qsizetype, qsizetype> FuelSystem::window(int x0, int x1) const {
+    auto lo = std::lower_bound(cans.cbegin(), cans.cend(), x0,
+                               [](const FuelCan& f, int x) { return f.wx < x; });
+    auto hi = std::upper_bound(lo, cans.cend(), x1,
+                               [](int x, const FuelCan& f) { return x < f.wx; });
+    return {lo - cans.cbegin(), hi - cans.cbegin()};
+}
+
+void FuelSystem::prune(int minX) {
+    const qsizetype n = window(std::numeric_limits<int>::min(), minX - 1).second;
+    if (n > 0) cans.remove(0, n);
+}
@@ -6,6 +6,7 @@
 #include <QPainter>
 #include <QHash>
 #include <random>
+#include <utility>
 #include "constants.h"
 #include "wheel.h"
 
@@ -17,6 +18,7 @@ struct FuelCan {
 
 class FuelSystem {
 public:
+    // Kept sorted by wx (cans are placed at the growing terrain edge).
     QVector<FuelCan> cans;
     int lastPlacedFuelX = 0;
 
@@ -24,8 +26,13 @@ public:
 
     void maybePlaceFuelAtEdge(int lastTerrainX, const QHash<int,int>& heightAtGX, double difficulty, double elapsedSeconds);
 
-    void drawWorldFuel(QPainter& p, int cameraX, int cameraY) const;
+    void drawWorldFuel(QPainter& p, int cameraX, int cameraY, int viewWidth) const;
     void handlePickups(const QList<Wheel*>& wheels, double& fuel);
+
+    // Index range [first, second) of the cans with x0 <= wx <= x1.
+    std::pair<qsizetype, qsizetype> window(int x0, int x1) const;
+    // Drops every can left of minX.
+    void prune(int minX);
 };
 
 #endif // FUEL_H
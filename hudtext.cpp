@@ -0,0 +1,39 @@
+// hudtext.cpp
+#include "hudtext.h"
+#include <QPainter>
+
+const QFont& HudText::font() {
+    static const QFont f = []{
+        QFont f; f.setFamily("Monospace"); f.setBold(true); f.setPointSize(12);
+        return f;
+    }();
+    return f;
+}
+
+const QFontMetrics& HudText::metrics() {
+    static const QFontMetrics fm(font());
+    return fm;
+}
+
+QHash<QString, QStaticText>& HudText::cache() {
+    static QHash<QString, QStaticText> c;
+    return c;
+}
+
+void HudText::draw(QPainter& p, int x, int y, const QString& s) {
+    auto& c = cache();
+    auto it = c.find(s);
+    if (it == c.end()) {
+        // The coin count and the countdowns pass through a new value every few
+        // frames while only a handful are on screen, so a full cache is simply
+        // emptied; whatever is still showing is laid out again next frame.
+        if (c.size() >= MAX_CACHED) c.clear();
+        QStaticText st(s);
+        st.setTextFormat(Qt::PlainText);
+        st.setPerformanceHint(QStaticText::AggressiveCaching);
+        st.prepare(QTransform(), font());
+        it = c.insert(s, st);
+    }
+    p.setFont(font());
+    p.drawStaticText(x, y - metrics().ascent(), it.value());
+}
@@ -0,0 +1,29 @@
+// hudtext.h
+#ifndef HUDTEXT_H
+#define HUDTEXT_H
+
+#include <QFont>
+#include <QFontMetrics>
+#include <QHash>
+#include <QStaticText>
+#include <QString>
+
+class QPainter;
+
+// Shared font and pre-laid-out strings for the in-game HUD, so the HUD painters
+// do not rebuild a QFont/QFontMetrics and reshape their text on every draw.
+class HudText {
+public:
+    static const QFont& font();
+    static const QFontMetrics& metrics();
+
+    // Same anchoring as QPainter::drawText(int, int, QString): (x, y) is the
+    // left end of the baseline. Uses the painter's current pen.
+    static void draw(QPainter& p, int x, int y, const QString& s);
+
+private:
+    static constexpr int MAX_CACHED = 64;
+    static QHash<QString, QStaticText>& cache();
+};
+
+#endif // HUDTEXT_H
@@ -6,6 +6,10 @@
 #include <cmath>
 #include <algorithm>
 #include "constants.h"
+#include "pixelfont.h"
+#include "circlespans.h"
+#include "startuptrace.h"
+#include "profilestore.h"
 
 constexpr int TITLE_STAGE_GAP_PX = 30;
 
@@ -136,7 +140,7 @@ void IntroScreen::maybeSpawnCloud() {
     }
 }
 
-void IntroScreen::drawClouds(QPainter& p) {
+void IntroScreen::drawClouds() {
     if (Constants::LEVELS[level_index].cloudProbability <= 0.001) return;
 
     int camGX = m_camX / Constants::PIXEL_SIZE;
@@ -149,6 +153,10 @@ void IntroScreen::drawClouds(QPainter& p) {
         return h;
     };
 
+    const QColor cloud = Constants::LEVELS[level_index].cloudColor;
+    const QRgb cMain = cloud.rgb();
+    const QRgb cSoft = QColor(cloud.red() * 0.9, cloud.green() * 0.9, cloud.blue() * 0.9).rgb();
+
     for (const Cloud& cl : m_clouds) {
         int baseGX = (cl.wx / Constants::PIXEL_SIZE) - camGX;
         int baseGY = cl.wyCells + camGY;
@@ -162,58 +170,35 @@ void IntroScreen::drawClouds(QPainter& p) {
                 quint32 h = hash2D(int(cl.seed) + xx, yy);
                 double fuzz = (h % 100) / 400.0;
 
-                if (r2 <= 1.0 + fuzz) {
-                    QColor cMain = Constants::LEVELS[level_index].cloudColor;
-                    QColor cSoft(cMain.red() * 0.9, cMain.green() * 0.9,
-                                 cMain.blue() * 0.9);
-                    QColor pix = ((h >> 3) & 1) ? cMain : cSoft;
-                    plotGridPixel(p, baseGX + xx, baseGY + yy, pix);
-                }
+                if (r2 <= 1.0 + fuzz) plotBg(baseGX + xx, baseGY + yy, ((h >> 3) & 1) ? cMain : cSoft);
             }
         }
     }
 }
 
-void IntroScreen::drawStars(QPainter& p) {
+void IntroScreen::drawStars() {
     if (Constants::LEVELS[level_index].starProbability <= 0.001) return;
 
-    const int BLOCK = 20;
     const int camGX = m_camX / Constants::PIXEL_SIZE;
     const int camGY = m_camY / Constants::PIXEL_SIZE;
 
-    const int startBX = (camGX) / BLOCK - 1;
-    const int endBX   = (camGX + gridW()) / BLOCK + 1;
-    const int startBY = (-camGY) / BLOCK - 1;
-    const int endBY   = (-camGY + gridH()) / BLOCK + 1;
-
-    for (int bx = startBX; bx <= endBX; ++bx) {
-        for (int by = startBY; by <= endBY; ++by) {
-            quint32 h = 120003212u;
-            h ^= quint32(bx); h *= 16777619u;
-            h ^= quint32(by); h *= 16777619u;
-            h = (h ^ bx) / (h ^ by) + (bx * by) - (3 * bx*bx + 4 * by*by);
-
-            std::mt19937 rng(h);
-            std::uniform_real_distribution<float> fdist(0.0f, 1.0f);
-
-            if (fdist(rng) < Constants::LEVELS[level_index].starProbability * 0.4) {
-                std::uniform_int_distribution<int> idist(0, BLOCK - 1);
-                int wgx = bx * BLOCK + idist(rng);
-                int wgy = by * BLOCK + idist(rng);
-
-                int groundGy = 0;
-                auto it = m_heightAtGX.constFind(wgx);
-                if (it != m_heightAtGX.constEnd()) groundGy = it.value();
-                else groundGy = 10000;
-
-                if (wgy < groundGy - 8) {
-                    int sgx = wgx - camGX;
-                    int sgy = wgy + camGY;
-                    int alpha = std::uniform_int_distribution<int>(100, 255)(rng);
-                    plotGridPixel(p, sgx, sgy, QColor(255, 255, 255, alpha));
-                }
-            }
-        }
+    m_starField.setDensity(Constants::LEVELS[level_index].starProbability * 0.4);
+    m_starField.prepare(camGX, -camGY, camGX + gridW(), -camGY + gridH());
+
+    m_starField.forEachVisible([&](const StarField::Star& s) {
+        const int sgx = s.wgx - camGX;
+        if (sgx < 0 || sgx >= m_groundColumns.size()) return;
+        if (s.wgy >= m_groundColumns[sgx] - 8) return;
+        blendBg(sgx, s.wgy + camGY, qPremultiply(qRgba(255, 255, 255, s.alpha)));
+    });
+}
+
+void IntroScreen::updateGroundColumns() {
+    const int camGX = m_camX / Constants::PIXEL_SIZE;
+    m_groundColumns.resize(gridW() + 1);
+    for (int sgx = 0; sgx <= gridW(); ++sgx) {
+        auto it = m_heightAtGX.constFind(sgx + camGX);
+        m_groundColumns[sgx] = (it == m_heightAtGX.constEnd()) ? NO_GROUND : it.value();
     }
 }
 
@@ -222,8 +207,7 @@ void IntroScreen::resizeEvent(QResizeEvent*) {
 }
 
 int IntroScreen::textWidthCells(const QString& s, int scale) const {
-    if (s.isEmpty()) return 0;
-    return (int(s.size()) - 1) * CHAR_ADV * scale + 5 * scale;
+    return PixelFont::standard().widthCells(s, scale);
 }
 
 int IntroScreen::fitTextScaleToRect(int wCells, int hCells, const QString& s) const {
@@ -239,45 +223,19 @@ int IntroScreen::fitTextScaleToRect(int wCells, int hCells, const QString& s) co
     return sc;
 }
 
-void IntroScreen::drawCircleFilledMidpointGrid(QPainter& p, int gcx, int gcy, int gr, const QColor& c) {
-    int x = 0;
-    int y = gr;
-    int d = 1 - gr;
-    auto span = [&](int cy, int xl, int xr) {
-        for (int xg = xl; xg <= xr; ++xg) plotGridPixel(p, xg, cy, c);
-    };
-    while (y >= x) {
-        span(gcy + y, gcx - x, gcx + x);
-        span(gcy - y, gcx - x, gcx + x);
-        span(gcy + x, gcx - y, gcx + y);
-        span(gcy - x, gcx - y, gcx + y);
-        ++x;
-        if (d < 0) d += 2 * x + 1;
-        else { --y; d += 2 * (x - y) + 1; }
-    }
-}
-
 void IntroScreen::paintEvent(QPaintEvent*) {
-    QImage bg(size(), QImage::Format_ARGB32_Premultiplied);
-    bg.fill(Constants::LEVELS[level_index].skyColor);
-    {
-        QPainter pb(&bg);
-        drawBackground(pb);
-    }
-
-    int sw = std::max(1, int(width() * m_blurScale));
-    int sh = std::max(1, int(height() * m_blurScale));
-    QImage small = bg.scaled(sw, sh, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    renderBackground();
 
+    // Integer nearest-neighbour upscale: every buffer pixel becomes one grid cell.
     QPainter p(this);
-    p.drawImage(rect(), small, small.rect());
+    p.drawImage(QRect(0, 0, m_bg.width() * Constants::PIXEL_SIZE, m_bg.height() * Constants::PIXEL_SIZE), m_bg);
 
     const int r = 3;
     int iconGX = 2 + r;
     int iconGY = 2 + r;
 
-    drawCircleFilledMidpointGrid(p, iconGX, iconGY, r, QColor(195,140,40));
-    drawCircleFilledMidpointGrid(p, iconGX, iconGY, std::max(1, r-1), QColor(250,204,77));
+    CircleSpans::drawRings(p, iconGX, iconGY, {{r, QColor(195,140,40)}, {std::max(1, r-1), QColor(250,204,77)}},
+                           QRect(0, 0, gridW() + 1, gridH() + 1));
     plotGridPixel(p, iconGX-1, iconGY-r+1, QColor(255,255,220));
 
     double scale = 1;
@@ -321,7 +279,7 @@ void IntroScreen::paintEvent(QPaintEvent*) {
                   rLevelNext.top()/Constants::PIXEL_SIZE  + (rLevelNext.height()/Constants::PIXEL_SIZE - 7*nextScale)/2,
                   nextScale, QColor(25,20,24), false);
 
-    QString levelName = Constants::LEVELS[level_index].name;
+    QString levelName = Constants::LEVELS[level_index].displayName();
     int levelScale = 2;
     int levelWCells = textWidthCells(levelName, levelScale);
     int levelGX = (gridW() - levelWCells) / 2;
@@ -402,19 +360,27 @@ void IntroScreen::paintEvent(QPaintEvent*) {
     int eGY = rExit.top()/Constants::PIXEL_SIZE   + (rExitHc  - 7*bsExit)/2;
 
     drawPixelText(p, sExit,  eGX, eGY,  bsExit,  QColor(20,20,20), false);
+
+    if (!m_firstFramePainted) {
+        m_firstFramePainted = true;
+        StartupTrace::mark("first paint");
+        emit firstFramePainted();
+    }
 }
 
 void IntroScreen::mousePressEvent(QMouseEvent* e) {
     if (buttonRectLevelPrev().contains(e->pos())) {
         level_index--;
-        if (level_index < 0) level_index = Constants::LEVELS.size() - 1;
+        if (level_index < 0) level_index = Constants::LEVEL_COUNT - 1;
+        emit levelHighlighted(level_index);
         update();
         return;
     }
 
     if (buttonRectLevelNext().contains(e->pos())) {
         level_index++;
-        if (level_index >= Constants::LEVELS.size()) level_index = 0;
+        if (level_index >= Constants::LEVEL_COUNT) level_index = 0;
+        emit levelHighlighted(level_index);
         update();
         return;
     }
@@ -513,23 +479,29 @@ QRect IntroScreen::buttonRectUnlock() const{
     return QRect(gx*Constants::PIXEL_SIZE, topPx, wCells*Constants::PIXEL_SIZE, hCells*Constants::PIXEL_SIZE);
 }
 
-void IntroScreen::drawBackground(QPainter& p) {
-    p.fillRect(rect(), Constants::LEVELS[level_index].skyColor);
-    drawStars(p);
-    drawClouds(p);
-    drawFilledTerrain(p);
+// The menu backdrop is drawn at one pixel per grid cell into a buffer that is
+// kept between frames, softened there, and scaled up to the widget in paintEvent.
+void IntroScreen::renderBackground() {
+    const QSize cells(gridW() + 1, gridH() + 1);
+    if (m_bg.size() != cells) m_bg = QImage(cells, QImage::Format_ARGB32_Premultiplied);
+
+    m_bg.fill(Constants::LEVELS[level_index].skyColor);
+    updateGroundColumns();
+    drawStars();
+    drawClouds();
+    drawFilledTerrain();
+    m_blur.apply(m_bg, m_blurRadius);
 }
 
-void IntroScreen::drawFilledTerrain(QPainter& p) {
+void IntroScreen::drawFilledTerrain() {
     const int camGX = m_camX / Constants::PIXEL_SIZE;
     const int camGY = m_camY / Constants::PIXEL_SIZE;
 
     for (int sgx = 0; sgx <= gridW(); ++sgx) {
         const int worldGX = sgx + camGX;
-        auto it = m_heightAtGX.constFind(worldGX);
-        if (it == m_heightAtGX.constEnd()) continue;
+        const int groundWorldGY = m_groundColumns[sgx];
+        if (groundWorldGY == NO_GROUND) continue;
 
-        const int groundWorldGY = it.value();
         int startScreenGY = groundWorldGY + camGY;
         if (startScreenGY < 0) startScreenGY = 0;
         if (startScreenGY >= gridH()) continue;
@@ -539,31 +511,24 @@ void IntroScreen::drawFilledTerrain(QPainter& p) {
 
             int depth = sGY - startScreenGY;
             if (level_index == 5) {
-                QColor c;
                 if (depth < 14) {
-                    if (depth == 0) c = QColor(80, 80, 85);
-                    else if (depth >= 6 && depth <= 7 && (worldGX % 20 < 10)) {
-                        c = QColor(240, 190, 40);
-                    }
-                    else c = QColor(50, 50, 55);
+                    QRgb c;
+                    if (depth == 0) c = qRgb(80, 80, 85);
+                    else if (depth >= 6 && depth <= 7 && (worldGX % 20 < 10)) c = qRgb(240, 190, 40);
+                    else c = qRgb(50, 50, 55);
 
-                    plotGridPixel(p, sgx, sGY, c);
+                    plotBg(sgx, sGY, c);
                     continue;
                 }
             }
 
             bool topZone = (sGY < groundWorldGY + camGY + 3*Constants::SHADING_BLOCK);
-            const QColor shade = grassShadeForBlock(worldGX, worldGY, topZone);
-            plotGridPixel(p, sgx, sGY, shade);
-
-            if (level_index != 5) {
-                const QColor edge = grassShadeForBlock(worldGX, groundWorldGY, true).darker(115);
-                plotGridPixel(p, sgx, groundWorldGY + camGY, edge);
-            }
+            plotBg(sgx, sGY, grassShadeForBlock(worldGX, worldGY, topZone).rgb());
         }
 
+        // The surface cell is drawn last so it sits on top of the fill.
         const QColor edge = grassShadeForBlock(worldGX, groundWorldGY, true).darker(115);
-        plotGridPixel(p, sgx, groundWorldGY + camGY, edge);
+        plotBg(sgx, groundWorldGY + camGY, edge.rgb());
     }
 }
 
@@ -660,75 +625,30 @@ void IntroScreen::ensureAheadTerrain(int worldX) {
 
 void IntroScreen::drawPixelText(QPainter& p, const QString& s, int gx, int gy, int scale, const QColor& c, bool bold)
 {
-    auto plot = [&](int x,int y,const QColor& col) {
-        plotGridPixel(p, gx + x, gy + y, col);
-    };
-
-    for (int i = 0; i < s.size(); ++i) {
-        const QChar ch = s.at(i).toUpper();
-        const auto rows = font_map.value(font_map.contains(ch) ? ch : QChar(' '));
-        int baseOff = i * CHAR_ADV * scale;
-        for (int ry = 0; ry < 7; ++ry) {
-            uint8_t row = rows[ry];
-            for (int rx = 0; rx < 5; ++rx) {
-                if (row & (1 << (4 - rx))) {
-                    for (int sy = 0; sy < scale; ++sy) {
-                        for (int sx = 0; sx < scale; ++sx) {
-                            if (bold) {
-                                plot(baseOff + rx*scale + sx - 1, ry*scale + sy, c);
-                                plot(baseOff + rx*scale + sx + 1, ry*scale + sy, c);
-                                plot(baseOff + rx*scale + sx, ry*scale + sy - 1, c);
-                                plot(baseOff + rx*scale + sx, ry*scale + sy + 1, c);
-                            }
-                            plot(baseOff + rx*scale + sx, ry*scale + sy, c);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    PixelFont::standard().draw(p, s, gx, gy, Constants::PIXEL_SIZE, scale, c, bold);
 }
 
 
 void IntroScreen::saveGrandCoins() const {
-    QSettings s("JU","F1PixelGrid");
-    s.setValue("grandCoins", m_grandTotalCoins);
-    s.sync();
+    ProfileStore::instance().setGrandCoins(qint64(m_grandTotalCoins));
 }
 
 void IntroScreen::loadGrandCoins() {
-    QSettings s("JU","F1PixelGrid");
-    m_grandTotalCoins = s.value("grandCoins", 0).toInt();
+    m_grandTotalCoins = quint64(ProfileStore::instance().grandCoins());
 }
 
 void IntroScreen::saveUnlocks() const {
-    QSettings s("JU","F1PixelGrid");
-
-    QVariantList unlockList;
-
-    for(bool unlocked : levels_unlocked) {
-        unlockList.append(unlocked);
-    }
-
-    s.setValue("unlocks", unlockList);
-    s.sync();
+    ProfileStore::instance().setUnlocks(levels_unlocked);
 }
 
 void IntroScreen::loadUnlocks() {
-    QSettings s("JU","F1PixelGrid");
-    QVariant unlockData = s.value("unlocks");
-
-    if (unlockData.isValid()) {
+    const QVector<bool>& saved = ProfileStore::instance().unlocks();
 
-        QVariantList savedList = unlockData.toList();
+    if (!saved.isEmpty()) {
 
-        levels_unlocked.clear();
-
-        for(const QVariant& item : savedList) {
-            levels_unlocked.append(item.toBool());
-        }
+        levels_unlocked = saved;
 
-        while(levels_unlocked.size() != Constants::LEVELS.size()) {
+        while(levels_unlocked.size() != Constants::LEVEL_COUNT) {
             levels_unlocked.append(false);
         }
 
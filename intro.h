@@ -8,10 +8,13 @@
 #include <QColor>
 #include <QVector>
 #include <QList>
+#include <QImage>
 #include "line.h"
 #include "constants.h"
-#include <QSettings>
+#include "starfield.h"
+#include "boxblur.h"
 #include <random>
+#include <limits>
 
 class QPainter;
 class QMouseEvent;
@@ -30,10 +33,15 @@ class IntroScreen : public QWidget {
 public:
     explicit IntroScreen(QWidget* parent = nullptr, int levelIndex = 0);
     void setGrandCoins(int v);
+    int levelIndex() const { return level_index; }
 
 signals:
     void startRequested(int levelIndex);
     void exitRequested();
+    // The level selector moved to another stage.
+    void levelHighlighted(int levelIndex);
+    // Emitted once, after the first frame has been painted.
+    void firstFramePainted();
 
 protected:
     void paintEvent(QPaintEvent*) override;
@@ -41,12 +49,27 @@ protected:
     void resizeEvent(QResizeEvent*) override;
 
 private:
-    void drawStars(QPainter& p);
-    void drawClouds(QPainter& p);
+    void drawStars();
+    void updateGroundColumns();
+    void drawClouds();
     void maybeSpawnCloud();
-    void drawBackground(QPainter& p);
-    void drawFilledTerrain(QPainter& p);
+    void renderBackground();
+    void drawFilledTerrain();
     void plotGridPixel(QPainter& p, int gx, int gy, const QColor& c);
+
+    // Writes into m_bg, where one pixel is one grid cell.
+    inline void plotBg(int gx, int gy, QRgb c) {
+        if (gx < 0 || gy < 0 || gx >= m_bg.width() || gy >= m_bg.height()) return;
+        reinterpret_cast<QRgb*>(m_bg.scanLine(gy))[gx] = c;
+    }
+    // Source-over for a premultiplied colour.
+    inline void blendBg(int gx, int gy, QRgb c) {
+        if (gx < 0 || gy < 0 || gx >= m_bg.width() || gy >= m_bg.height()) return;
+        QRgb& d = reinterpret_cast<QRgb*>(m_bg.scanLine(gy))[gx];
+        const int inv = 255 - qAlpha(c);
+        d = qRgba(qRed(c)   + qRed(d)   * inv / 255, qGreen(c) + qGreen(d) * inv / 255,
+                  qBlue(c)  + qBlue(d)  * inv / 255, qAlpha(c) + qAlpha(d) * inv / 255);
+    }
     void rasterizeSegmentToHeightMapWorld(int x1, int y1, int x2, int y2);
     void pruneHeightMap();
     void ensureAheadTerrain(int worldX);
@@ -73,7 +96,6 @@ private:
     // Grid helpers
     inline int gridW() const { return width()  / PIXEL_SIZE; }
     inline int gridH() const { return height() / PIXEL_SIZE; }
-    void drawCircleFilledMidpointGrid(QPainter& p, int gcx, int gcy, int gr, const QColor& c);
 
     QTimer m_timer;
     double m_scrollX = 0.0;
@@ -81,6 +103,10 @@ private:
     QList<Line> m_lines;
     QHash<int,int> m_heightAtGX;
     QVector<Cloud> m_clouds;
+    StarField m_starField;
+
+    static constexpr int NO_GROUND = std::numeric_limits<int>::max();
+    QVector<int> m_groundColumns;
 
     int m_lastCloudSpawnX = 0;
     int m_lastX = 0;
@@ -101,15 +127,17 @@ private:
 
     std::mt19937 m_rng;
 
-    static constexpr int CHAR_ADV = 7;
 
     int m_camX = 0;
     int m_camY = 200;
     int m_camXFarthest = 0;
 
-    qreal m_blurScale = 0.6;
+    QImage m_bg;
+    BoxBlur m_blur;
+    int m_blurRadius = 1;
 
     quint64 m_grandTotalCoins = 0;
+    bool m_firstFramePainted = false;
 
     // Title helpers (existing)
     int titleScale() const;
@@ -1,5 +1,6 @@
 #include "keylog.h"
 #include "constants.h"
+#include "pixelfont.h"
 #include <QRect>
 #include <algorithm>
 
@@ -51,8 +52,7 @@ void KeyLog::drawKey(QPainter& p, int gx, int gy, int w, int h, int ps, QChar la
 }
 
 void KeyLog::drawGlyph(QPainter& p, int gx, int gy, int w, int h, int ps, QChar ch, const QColor& color) {
-    auto it = font_map.find(ch.toUpper());
-    if (it == font_map.end()) return;
+    if (!font_map.find(ch.toUpper())) return;
 
     const int gw = 5, gh = 7;
     const int pad = 2;
@@ -62,15 +62,5 @@ void KeyLog::drawGlyph(QPainter& p, int gx, int gy, int w, int h, int ps, QChar
     const int ox = gx + pad + (innerW - gw*cell)/2;
     const int oy = gy + pad + (innerH - gh*cell)/2;
 
-    const auto& rows = it.value();
-    for (int r=0; r<gh; ++r) {
-        uint8_t row = rows[r];
-        for (int c=0; c<gw; ++c) {
-            if (row & (1 << (gw-1-c))) {
-                for (int yy=0; yy<cell; ++yy)
-                    for (int xx=0; xx<cell; ++xx)
-                        plot(p, ox + c*cell + xx, oy + r*cell + yy, ps, color);
-            }
-        }
-    }
+    PixelFont::standard().draw(p, QString(ch), ox, oy, ps, cell, color);
 }
@@ -0,0 +1,183 @@
+// leaderboardsync.cpp
+#include "leaderboardsync.h"
+#include "runlog.h"
+#include "profilestore.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRandomGenerator>
+#include <QSysInfo>
+#include <algorithm>
+
+namespace {
+
+constexpr int TRANSFER_TIMEOUT_MS = 10000;
+
+QString deviceId() {
+    const QByteArray id = QSysInfo::machineUniqueId();
+    if (!id.isEmpty()) return QString::fromLatin1(id.toHex());
+    const QString host = QSysInfo::machineHostName();
+    if (!host.isEmpty()) return host;
+    return QStringLiteral("UNKNOWN_DEVICE");
+}
+
+// {"d":device,"o":first run number,"r":[[stage,score,distanceDm,durationMs,coins,flips,nitro,seed,endedAtMs],...]}
+QByteArray batchBody(const QString& device, int offset, const RunLog& log, int count) {
+    QJsonArray runs;
+    for (int i = 0; i < count; ++i) {
+        const RunRecord& r = log.at(offset + i);
+        runs.append(QJsonArray{ r.stage, r.score, r.distanceDm, qint64(r.durationMs), r.coins,
+                                r.flips, r.nitroUses, qint64(r.seed), r.endedAtMs });
+    }
+    return QJsonDocument(QJsonObject{ {"d", device}, {"o", offset}, {"r", runs} }).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+// Lives on LeaderboardSync's thread; owns the network access manager there.
+class SyncWorker : public QObject {
+public:
+    explicit SyncWorker(const QUrl& service) : m_service(service) {}
+
+    // `done` gets the HTTP status, or 0 if no response arrived.
+    void post(const QByteArray& body, int count, LeaderboardSync* owner,
+              void (LeaderboardSync::*done)(bool, int, int)) {
+        QNetworkReply* reply = nam().post(request(QStringLiteral("/runs")), body);
+        connect(reply, &QNetworkReply::finished, this, [reply, count, owner, done] {
+            const bool ok = reply->error() == QNetworkReply::NoError;
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            reply->deleteLater();
+            QMetaObject::invokeMethod(owner, [owner, done, ok, status, count] { (owner->*done)(ok, status, count); },
+                                      Qt::QueuedConnection);
+        });
+    }
+
+    void get(LeaderboardSync* owner, void (LeaderboardSync::*done)(const QByteArray&)) {
+        QNetworkReply* reply = nam().get(request(QStringLiteral("/best")));
+        connect(reply, &QNetworkReply::finished, this, [reply, owner, done] {
+            const QByteArray body = reply->error() == QNetworkReply::NoError ? reply->readAll() : QByteArray();
+            reply->deleteLater();
+            if (body.isEmpty()) return;
+            QMetaObject::invokeMethod(owner, [owner, done, body] { (owner->*done)(body); },
+                                      Qt::QueuedConnection);
+        });
+    }
+
+private:
+    // Created on first use so it belongs to this thread.
+    QNetworkAccessManager& nam() {
+        if (!m_nam) m_nam = new QNetworkAccessManager(this);
+        return *m_nam;
+    }
+
+    QNetworkRequest request(const QString& path) const {
+        QUrl url = m_service;
+        url.setPath(url.path() + path);
+        QNetworkRequest req(url);
+        req.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+        req.setTransferTimeout(TRANSFER_TIMEOUT_MS);
+        return req;
+    }
+
+    QUrl m_service;
+    QNetworkAccessManager* m_nam = nullptr;
+};
+
+LeaderboardSync* LeaderboardSync::fromEnvironment(const RunLog& log, QObject* parent) {
+    const QUrl url(qEnvironmentVariable("BB_LEADERBOARD_URL"));
+    if (!url.isValid() || (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https")))
+        return nullptr;
+    return new LeaderboardSync(url, log, parent);
+}
+
+LeaderboardSync::LeaderboardSync(const QUrl& service, const RunLog& log, QObject* parent)
+    : QObject(parent), m_log(log), m_device(deviceId()) {
+    m_remoteBest.fill(-1);
+
+    m_sendTimer.setSingleShot(true);
+    connect(&m_sendTimer, &QTimer::timeout, this, &LeaderboardSync::sendBatch);
+
+    m_worker = new SyncWorker(service);
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_thread.setObjectName(QStringLiteral("LeaderboardSync"));
+    m_thread.start(QThread::LowPriority);
+
+    // A run log that was reset or replaced is shorter than what the profile
+    // says was sent; start counting again from its end.
+    ProfileStore& profile = ProfileStore::instance();
+    if (profile.syncedRuns() > m_log.size()) {
+        qWarning("LeaderboardSync: runs.log has %d runs but %d were synced, resuming from %d",
+                 m_log.size(), profile.syncedRuns(), m_log.size());
+        profile.setSyncedRuns(m_log.size());
+    }
+
+    // Anything left over from earlier sessions goes out right away.
+    if (profile.syncedRuns() < m_log.size()) m_sendTimer.start(0);
+}
+
+LeaderboardSync::~LeaderboardSync() {
+    // Unsent runs stay in the log and go out next launch.
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void LeaderboardSync::runsAppended() {
+    if (m_inFlight || m_sendTimer.isActive()) return;
+    m_sendTimer.start(BATCH_DELAY_MS);
+}
+
+void LeaderboardSync::fetchBest() {
+    QMetaObject::invokeMethod(m_worker, [w = m_worker, this] { w->get(this, &LeaderboardSync::bestFetched); },
+                              Qt::QueuedConnection);
+}
+
+int LeaderboardSync::remoteBest(int stage) const {
+    if (stage < 0 || stage >= int(m_remoteBest.size())) return -1;
+    return m_remoteBest[stage];
+}
+
+void LeaderboardSync::sendBatch() {
+    const int offset = std::min(ProfileStore::instance().syncedRuns(), m_log.size());
+    const int count = std::min(MAX_BATCH, m_log.size() - offset);
+    if (count <= 0 || m_inFlight) return;
+
+    m_inFlight = true;
+    const QByteArray body = batchBody(m_device, offset, m_log, count);
+    QMetaObject::invokeMethod(m_worker, [w = m_worker, this, body, count] {
+        w->post(body, count, this, &LeaderboardSync::batchDone);
+    }, Qt::QueuedConnection);
+}
+
+void LeaderboardSync::batchDone(bool ok, int httpStatus, int count) {
+    m_inFlight = false;
+    ProfileStore& profile = ProfileStore::instance();
+    // Timeouts and throttling are worth retrying; other 4xx will never succeed.
+    const bool rejected = httpStatus >= 400 && httpStatus < 500 && httpStatus != 408 && httpStatus != 429;
+    if (!ok && rejected) {
+        qWarning("LeaderboardSync: service rejected runs %d-%d with HTTP %d, skipping them",
+                 profile.syncedRuns(), profile.syncedRuns() + count - 1, httpStatus);
+    } else if (!ok) {
+        const int jitter = int(QRandomGenerator::global()->bounded(m_backoffMs / 4 + 1));
+        m_sendTimer.start(m_backoffMs + jitter);
+        m_backoffMs = std::min(m_backoffMs * 2, MAX_BACKOFF_MS);
+        return;
+    }
+    m_backoffMs = MIN_BACKOFF_MS;
+    profile.setSyncedRuns(profile.syncedRuns() + count);
+    if (profile.syncedRuns() < m_log.size()) m_sendTimer.start(0);
+}
+
+// {"b":[[stage,score],...]}
+void LeaderboardSync::bestFetched(const QByteArray& body) {
+    const QJsonArray best = QJsonDocument::fromJson(body).object().value("b").toArray();
+    for (const QJsonValue& v : best) {
+        const QJsonArray pair = v.toArray();
+        const int stage = pair.at(0).toInt(-1);
+        if (stage >= 0 && stage < int(m_remoteBest.size())) m_remoteBest[stage] = pair.at(1).toInt(-1);
+    }
+    emit remoteUpdated();
+}
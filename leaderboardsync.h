@@ -0,0 +1,69 @@
+// leaderboardsync.h
+#ifndef LEADERBOARDSYNC_H
+#define LEADERBOARDSYNC_H
+
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QUrl>
+#include <array>
+#include "constants.h"
+
+class RunLog;
+class SyncWorker;
+
+// Optional upload of the local run log to a shared leaderboard service, and
+// download of the service's best score per stage. Enabled by pointing
+// BB_LEADERBOARD_URL at the service (tools/leaderboard_server.py is a local
+// stand-in).
+//
+// The run log is the outbox: the profile remembers how many runs the service
+// has acknowledged, and everything after that is sent in batches of up to
+// MAX_BATCH runs. Requests run on a worker thread with its own
+// QNetworkAccessManager, so nothing here ever waits on the network. A batch
+// that fails on the network, times out, is throttled or hits a 5xx is retried
+// with exponential backoff and jitter; any other 4xx means the service will
+// never take it, so it is logged and skipped. Each batch carries its starting
+// run number, so a retried batch the service already stored is not counted
+// twice. GUI thread only.
+class LeaderboardSync : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int BATCH_DELAY_MS  = 3000;
+    static constexpr int MAX_BATCH       = 50;
+    static constexpr int MIN_BACKOFF_MS  = 2000;
+    static constexpr int MAX_BACKOFF_MS  = 5 * 60 * 1000;
+
+    // Null if BB_LEADERBOARD_URL is unset or not a valid http(s) URL.
+    static LeaderboardSync* fromEnvironment(const RunLog& log, QObject* parent = nullptr);
+
+    LeaderboardSync(const QUrl& service, const RunLog& log, QObject* parent = nullptr);
+    ~LeaderboardSync();
+
+    // Call after appending to the run log; the upload is batched.
+    void runsAppended();
+    // Asks the service for its best scores; remoteUpdated() follows if it answers.
+    void fetchBest();
+
+    // Last best score the service reported for a stage, or -1.
+    int remoteBest(int stage) const;
+
+signals:
+    void remoteUpdated();
+
+private:
+    void sendBatch();
+    void batchDone(bool ok, int httpStatus, int count);
+    void bestFetched(const QByteArray& body);
+
+    const RunLog& m_log;
+    QString m_device;
+    QThread m_thread;
+    SyncWorker* m_worker = nullptr;
+    QTimer m_sendTimer;
+    bool m_inFlight = false;
+    int m_backoffMs = MIN_BACKOFF_MS;
+    std::array<int, Constants::LEVEL_COUNT> m_remoteBest;
+};
+
+#endif // LEADERBOARDSYNC_H
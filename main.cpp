@@ -1,11 +1,27 @@
 #include "mainwindow.h"
+#include "startuptrace.h"
+#include "profilestore.h"
+#include "telemetry.h"
+#include "trace.h"
 #include <QApplication>
 #include <QPixmapCache>
 
 int main(int argc, char *argv[]) {
+    // driver --telemetry-csv <dump> [out.csv]
+    if (argc >= 3 && qstrcmp(argv[1], "--telemetry-csv") == 0) {
+        const QString in = QString::fromLocal8Bit(argv[2]);
+        const QString out = argc >= 4 ? QString::fromLocal8Bit(argv[3]) : in + QStringLiteral(".csv");
+        return Telemetry::writeCsv(in, out) ? 0 : 1;
+    }
+
+    StartupTrace::start();
+    Trace::init();
     QApplication a(argc, argv);
     QPixmapCache::setCacheLimit(128 * 4096);
+    ProfileStore profile;
+    StartupTrace::mark("profile loaded");
     MainWindow w;
     w.show();
+    StartupTrace::mark("window shown");
     return a.exec();
 }//
@@ -2,8 +2,16 @@
 #include "coin.h"
 #include "outro.h"
 #include "constants.h" // Ensure this includes the new struct definition
-#include <QSettings>
+#include "hudtext.h"
+#include "circlespans.h"
+#include "startuptrace.h"
+#include "profilestore.h"
+#include "trace.h"
 #include <QCloseEvent>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QDebug>
 #include <QPainter>
 #include <QKeyEvent>
 #include <QPalette>
@@ -11,8 +19,6 @@
 #include <QFont>
 #include <cmath>
 #include <algorithm>
-#include <map>
-#include <list>
 #include <limits>
 
 MainWindow::MainWindow(QWidget *parent)
@@ -21,8 +27,16 @@ MainWindow::MainWindow(QWidget *parent)
     m_dist(0.0f, 1.0f)
 {
     setWindowTitle("Driver (Pixel Grid)");
+
+    bool threadsOk = false;
+    const int renderThreads = qEnvironmentVariableIntValue("BB_RENDER_THREADS", &threadsOk);
+    m_frameBands.setThreadCount(threadsOk ? renderThreads : Constants::RENDER_THREADS);
     setFocusPolicy(Qt::StrongFocus);
 
+    const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    m_telemetry.installCrashHandler(dataDir + QStringLiteral("/telemetry-crash.bbtl"));
+
     m_pause = new PauseOverlay(this);
     m_pause->setGeometry(rect());
     m_pause->hide();
@@ -35,19 +49,10 @@ MainWindow::MainWindow(QWidget *parent)
 
     showFullScreen();
 
-    m_media = new Media(this);
-    m_media->setupBgm();
-    m_media->setBgmVolume(0.35);
-    m_media->playBgm();
-
-    m_leaderboardMgr = new LeaderboardManager(this);
     m_leaderboardWidget = new LeaderboardWidget(this);
     m_leaderboardWidget->setGeometry(rect());
     m_leaderboardWidget->hide();
 
-    connect(m_leaderboardMgr, &LeaderboardManager::leaderboardUpdated,
-            m_leaderboardWidget, &LeaderboardWidget::setEntries);
-
     connect(m_leaderboardWidget, &LeaderboardWidget::closed, this, [this]{
         // Resume game when leaderboard is closed (if we were in-game)
         if (m_timer && !m_intro && !m_outro) {
@@ -56,8 +61,6 @@ MainWindow::MainWindow(QWidget *parent)
         setFocus();
     });
 
-    loadGrandCoins();
-
     m_timer = new QTimer(this);
     connect(m_timer, &QTimer::timeout, this, &MainWindow::gameLoop);
     m_timer->start(10);
@@ -72,6 +75,12 @@ MainWindow::MainWindow(QWidget *parent)
     m_intro->setGeometry(rect());
     m_intro->show();
     m_timer->stop();
+    Perf::resetFrameClock();
+
+    // Audio, scores and sprite warmup start once the intro is on screen.
+    connect(m_intro, &IntroScreen::firstFramePainted, this, &MainWindow::loadDeferredAssets,
+            Qt::QueuedConnection);
+    connectIntroAudio();
 
     connect(m_intro, &IntroScreen::exitRequested, this, &QWidget::close);
     connect(m_intro, &IntroScreen::startRequested, this, [this](int levelIndex){
@@ -99,6 +108,44 @@ MainWindow::~MainWindow() {
     qDeleteAll(m_wheels);
 }
 
+void MainWindow::loadDeferredAssets() {
+    if (m_deferredLoaded) return;
+    m_deferredLoaded = true;
+    StartupTrace::mark("deferred load");
+
+    // Audio is mapped from the PCM cache or decoded on the mixer thread;
+    // Media::ready fires once the SFX and the intro track are loaded.
+    m_media = new Media(this);
+    connect(m_media, &Media::ready, this, &MainWindow::assetReady);
+    m_media->setupBgm();
+    m_media->setBgmVolume(0.35);
+    m_media->playBgm();
+    if (m_intro) m_media->prefetchStageBgm(m_intro->levelIndex());
+
+    m_leaderboardMgr = new LeaderboardManager(this);
+    connect(m_leaderboardMgr, &LeaderboardManager::leaderboardUpdated,
+            m_leaderboardWidget, &LeaderboardWidget::setEntries);
+
+    loadGrandCoins();
+
+    m_carSprites.setShape(Constants::CAR_BODY_POINTS, Constants::CAR_COLOR,
+                          { qMakePair(Constants::CAR_GLASS_POINTS, Constants::CAR_GLASS_COLOR),
+                            qMakePair(Constants::CAR_HANDLE_POINTS, Constants::CAR_HANDLE_COLOR) });
+    startSpriteWarmup();
+}
+
+void MainWindow::connectIntroAudio() {
+    connect(m_intro, &IntroScreen::levelHighlighted, this, [this](int levelIndex) {
+        if (m_media) m_media->prefetchStageBgm(levelIndex);
+    });
+}
+
+void MainWindow::assetReady() {
+    if (m_assetsPending <= 0 || --m_assetsPending > 0) return;
+    StartupTrace::mark("all assets ready");
+    StartupTrace::report();
+}
+
 
 void MainWindow::resizeEvent(QResizeEvent *e) {
     QWidget::resizeEvent(e);
@@ -166,6 +213,8 @@ void MainWindow::createCar() {
 
 
 void MainWindow::gameLoop() {
+    TRACE_SCOPE("gameLoop");
+    const qint64 tickStartNs = m_telemetry.nowNs();
     const qint64 now = m_clock.nsecsElapsed();
     static qint64 prev = now;
     const qint64 dtns = now - prev;
@@ -213,7 +262,10 @@ void MainWindow::gameLoop() {
     const int offRightX  = viewRightX + marginPx;
     const int maxStreamWidthPx =
         (Constants::COIN_GROUP_MAX - 1) * Constants::COIN_GROUP_STEP_MAX * Constants::PIXEL_SIZE;
-    ensureAheadTerrain(offRightX + maxStreamWidthPx + Constants::PIXEL_SIZE * 20);
+    {
+        PERF_SCOPE(Terrain);
+        ensureAheadTerrain(offRightX + maxStreamWidthPx + Constants::PIXEL_SIZE * 20);
+    }
 
     m_coinSys.maybePlaceCoinStreamAtEdge(
         m_elapsedSeconds, m_cameraX, width(), m_heightAtGX, m_lastX, m_rng, m_dist);
@@ -241,10 +293,13 @@ void MainWindow::gameLoop() {
         } else { accelDrive = false; brakeDrive = false; }
     }
 
-    for (Wheel* w : m_wheels) w->simulate(level_index, m_lines, accelDrive, brakeDrive, nitroDrive);
-    for (CarBody* b : m_bodies) b->simulate(level_index, m_lines, accelDrive, brakeDrive);
+    {
+        PERF_SCOPE(Physics);
+        m_stage->stepCar(m_wheels, m_bodies, m_lines, accelDrive, brakeDrive, nitroDrive);
+        for (CarBody* body : m_bodies) body->updateOutline();
 
-    m_nitroSys.applyThrust(m_wheels);
+        m_nitroSys.applyThrust(m_wheels);
+    }
 
     if (m_fuel > 0.0) {
         double baseBurn = Constants::FUEL_BASE_BURN_PER_SEC * dt;
@@ -259,60 +314,15 @@ void MainWindow::gameLoop() {
         if (w->x < minX) { w->x = minX; w->m_vx = 0; }
     }
 
-    if (!isFullyUpsideDown()) {
-        m_fuelSys.handlePickups(m_wheels, m_fuel);
-        m_coinSys.handlePickups(m_wheels, m_coinCount);
-    }
-    if (m_coinCount > coinsBefore) m_media->coinPickup();
-    if ((m_fuel - fuelBefore) > 1e-3 && !m_suppressFuelSfx) m_media->fuelPickup();
+    // Wheels only collect while the car is upright; the body always does.
+    const bool upright = !isFullyUpsideDown();
     {
-        auto ptSegDist2 = [](double px, double py, const Line& ln)->double {
-            double x1 = ln.getX1(), y1 = ln.getY1();
-            double x2 = ln.getX2(), y2 = ln.getY2();
-            double vx = x2 - x1,   vy = y2 - y1;
-            double wx = px - x1,   wy = py - y1;
-            double len2 = vx*vx + vy*vy;
-            double t = (len2 > 0.0) ? (wx*vx + wy*vy) / len2 : 0.0;
-            if (t < 0.0) t = 0.0; else if (t > 1.0) t = 1.0;
-            double cx = x1 + t*vx, cy = y1 + t*vy;
-            double dx = px - cx,   dy = py - cy;
-            return dx*dx + dy*dy;
-        };
-
-        const double R2 = double(Constants::COIN_PICKUP_RADIUS) * double(Constants::COIN_PICKUP_RADIUS);
-
-        for (auto& coin : m_coinSys.coins) {
-            if (coin.taken) continue;
-            bool hit = false;
-
-            for (CarBody* body : m_bodies) {
-                const auto edges = body->getLines();
-                for (const Line& ln : edges) {
-                    if (ptSegDist2(coin.cx, coin.cy, ln) <= R2) {
-                        hit = true;
-                        break;
-                    }
-                }
-
-                if (!hit) {
-                    const auto bodyPoints = body->get(0, 0);
-                    QPolygon polygon;
-                    for (const QPoint& p : bodyPoints)
-                        polygon << QPoint(p.x(), p.y());
-                    if (polygon.containsPoint(QPoint(coin.cx, coin.cy), Qt::OddEvenFill))
-                        hit = true;
-                }
-
-                if (hit) break;
-            }
-
-            if (hit) {
-                coin.taken = true;
-                ++m_coinCount;
-            }
-        }
-
+        PERF_SCOPE(Pickups);
+        if (upright) m_fuelSys.handlePickups(m_wheels, m_fuel);
+        m_coinSys.handlePickups(upright ? m_wheels : QList<Wheel*>(), m_bodies, m_coinCount);
     }
+    if (m_media && m_coinCount > coinsBefore) m_media->coinPickup();
+    if (m_media && (m_fuel - fuelBefore) > 1e-3 && !m_suppressFuelSfx) m_media->fuelPickup();
 
     const bool fuelEmpty = (m_fuel <= 0.0);
     const bool roofHit   = !m_bodies[0]->isAlive();
@@ -330,9 +340,46 @@ void MainWindow::gameLoop() {
         disarmGameOver();
     }
 
+    recordTelemetry(dtns, tickStartNs);
     update();
 }
 
+void MainWindow::recordTelemetry(qint64 dtNs, qint64 tickStartNs) {
+    TelemetryFrame f;
+    f.tNs      = tickStartNs;
+    f.dtMs     = float(dtNs / 1e6);
+    f.simMs    = float((m_telemetry.nowNs() - tickStartNs) / 1e6);
+    f.renderMs = m_telemetry.renderMs();
+    if (!m_bodies.isEmpty()) {
+        f.x = float(m_bodies.first()->getX());
+        f.y = float(m_bodies.first()->getY());
+    }
+    if (!m_wheels.isEmpty()) {
+        double vx = 0.0, vy = 0.0;
+        for (const Wheel* w : m_wheels) { vx += w->m_vx; vy += w->m_vy; }
+        f.vx = float(vx / m_wheels.size());
+        f.vy = float(vy / m_wheels.size());
+    }
+    f.fuel     = float(m_fuel);
+    f.segments = quint32(m_lines.size());
+    f.coins    = quint16(std::min<qsizetype>(m_coinSys.coins.size(), 0xFFFF));
+    f.cans     = quint16(std::min<qsizetype>(m_fuelSys.cans.size(), 0xFFFF));
+    f.props    = quint16(std::min(m_propSys.count(), 0xFFFF));
+    f.inputs   = quint8((m_accelerating ? TelemetryFrame::Accel : 0)
+                      | (m_braking ? TelemetryFrame::Brake : 0)
+                      | (m_nitroKey ? TelemetryFrame::NitroKey : 0)
+                      | (m_nitroSys.active ? TelemetryFrame::NitroActive : 0));
+    m_telemetry.record(f);
+}
+
+void MainWindow::dumpTelemetry() {
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    const QString path = dir + QStringLiteral("/telemetry-%1.bbtl")
+                                   .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss")));
+    if (m_telemetry.dump(path)) qInfo().noquote() << "telemetry written to" << path;
+    else qWarning().noquote() << "telemetry: could not write" << path;
+}
+
 int MainWindow::leftmostTerrainX() const {
     if (m_lines.isEmpty()) return 0;
     return m_lines.first().getX1();
@@ -340,6 +387,8 @@ int MainWindow::leftmostTerrainX() const {
 
 void MainWindow::paintEvent(QPaintEvent *event) {
     Q_UNUSED(event);
+    TRACE_SCOPE("paintEvent");
+    const qint64 paintStartNs = m_telemetry.nowNs();
     QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, true);
     p.setPen(Qt::NoPen);
@@ -349,64 +398,114 @@ void MainWindow::paintEvent(QPaintEvent *event) {
     const int offX  = -(m_cameraX - camGX * Constants::PIXEL_SIZE);
     const int offY  =  (m_cameraY - camGY * Constants::PIXEL_SIZE);
 
+    updateGroundColumns();
+    {
+        PERF_SCOPE(Sky);
+        prepareStars();
+    }
+
+    // Frame row 0 is the cell row just above the screen, which offY can expose
+    // by up to PIXEL_SIZE-1 pixels.
+    m_frameBands.resize(gridW() + 1, gridH() + 2);
+    const QColor sky = Constants::LEVELS[level_index].skyColor;
+    m_frameBands.render([this, &sky](QImage& slice, int row0, int row1) {
+        TRACE_SCOPE("band");
+        slice.fill(sky);
+        const FrameBands::Pixels px = FrameBands::pixels(slice, row0 - 1, row1 - 1);
+        QPainter bp(&slice);
+        bp.setPen(Qt::NoPen);
+        bp.setTransform(QTransform(1.0 / Constants::PIXEL_SIZE, 0, 0, 1.0 / Constants::PIXEL_SIZE, 0, 1 - row0));
+        renderWorldBand(bp, px);
+    });
+
+    {
+        // Trees and buildings are taller than a band, so props are painted once
+        // into the joined frame rather than again in every band they touch.
+        PERF_SCOPE(Props);
+        QPainter fp(&m_frameBands.image());
+        fp.setPen(Qt::NoPen);
+        fp.setTransform(QTransform(1.0 / Constants::PIXEL_SIZE, 0, 0, 1.0 / Constants::PIXEL_SIZE, 0, 1));
+        m_propSys.draw(fp, m_cameraX, m_cameraY, width(), height(), m_heightAtGX);
+    }
+
+    const QImage& frame = m_frameBands.image();
+    p.drawImage(QRect(offX, offY - Constants::PIXEL_SIZE,
+                      frame.width() * Constants::PIXEL_SIZE, frame.height() * Constants::PIXEL_SIZE),
+                frame);
+
     p.save();
     p.translate(offX, offY);
 
     if (m_showGrid) { drawGridOverlay(p); }
-    drawStars(p);
-    drawClouds(p);
-    drawFilledTerrain(p);
-    m_propSys.draw(p, m_cameraX, m_cameraY, width(), height(), m_heightAtGX);
-    m_fuelSys.drawWorldFuel(p, m_cameraX, m_cameraY);
+    m_fuelSys.drawWorldFuel(p, m_cameraX, m_cameraY, width());
     m_coinSys.drawWorldCoins(p, m_cameraX, m_cameraY, gridW(), gridH());
     m_nitroSys.drawFlame(p, m_wheels, m_cameraX, m_cameraY, width(), height());
 
-    for (const Wheel* wheel : m_wheels) {
-        if (auto info = wheel->get(0, 0, width(), height(), -m_cameraX, m_cameraY)) {
-            const int cx = (*info)[0];
-            const int cy = (*info)[1];
-            const int r  = (*info)[2];
-            if(r == 0) continue;
-            const int gcx = cx / Constants::PIXEL_SIZE;
-            const int gcy = cy / Constants::PIXEL_SIZE;
-            const int gr  = r  / Constants::PIXEL_SIZE;
-            drawCircleFilledMidpointGrid(p, gcx, gcy, gr, Constants::WHEEL_COLOR_OUTER);
-            const int tyreCells = std::max(1, Constants::TYRE_THICKNESS / Constants::PIXEL_SIZE);
-            const int innerR = std::max(1, gr - tyreCells);
-            drawCircleFilledMidpointGrid(p, gcx, gcy, innerR, Constants::WHEEL_COLOR_INNER);
+    {
+        PERF_SCOPE(Car);
+        for (const Wheel* wheel : m_wheels) {
+            if (auto info = wheel->get(0, 0, width(), height(), -m_cameraX, m_cameraY)) {
+                const int cx = (*info)[0];
+                const int cy = (*info)[1];
+                const int r  = (*info)[2];
+                if(r == 0) continue;
+                const int gcx = cx / Constants::PIXEL_SIZE;
+                const int gcy = cy / Constants::PIXEL_SIZE;
+                const int gr  = r  / Constants::PIXEL_SIZE;
+                const int tyreCells = std::max(1, Constants::TYRE_THICKNESS / Constants::PIXEL_SIZE);
+                const int innerR = std::max(1, gr - tyreCells);
+                CircleSpans::drawRings(p, gcx, gcy, {{gr, Constants::WHEEL_COLOR_OUTER}, {innerR, Constants::WHEEL_COLOR_INNER}},
+                                       QRect(0, 0, gridW() + 1, gridH() + 1));
+            }
         }
-    }
 
-    for(CarBody* body : m_bodies){
-        auto pts = body->get(-m_cameraX, m_cameraY);
-        QVector<QPoint> normalisedPoints;
-        normalisedPoints.reserve(pts.size());
-        for(auto p2 : pts){
-            normalisedPoints.append(QPoint(p2.x() / Constants::PIXEL_SIZE, p2.y() / Constants::PIXEL_SIZE));
-        }
-        fillPolygon(p, normalisedPoints, Constants::CAR_COLOR);
-
-        auto attach = body->getAttachments(-m_cameraX, m_cameraY);
-        for (const auto& ap : attach) {
-            QVector<QPoint> norm;
-            norm.reserve(ap.first.size());
-            for (const QPoint& q : ap.first) {
-                norm.append(QPoint(q.x() / Constants::PIXEL_SIZE, q.y() / Constants::PIXEL_SIZE));
+        for(CarBody* body : m_bodies){
+            if (Constants::CAR_SPRITE_BUCKETS > 0) {
+                const auto& sprite = m_carSprites.sprite(body->getShapeAngle());
+                const int gx = int(std::floor(double(body->getX() - m_cameraX) / Constants::PIXEL_SIZE)) + sprite.originCellX;
+                const int gy = int(std::floor(double(body->getY() + m_cameraY) / Constants::PIXEL_SIZE)) + sprite.originCellY;
+                p.drawImage(QRect(gx * Constants::PIXEL_SIZE, gy * Constants::PIXEL_SIZE,
+                                  sprite.image.width() * Constants::PIXEL_SIZE, sprite.image.height() * Constants::PIXEL_SIZE),
+                            sprite.image);
+                continue;
+            }
+
+            const auto pts = body->get(-m_cameraX, m_cameraY);
+            fillPolygon(p, pts.constData(), int(pts.size()), Constants::CAR_COLOR);
+
+            const auto attach = body->getAttachments(-m_cameraX, m_cameraY);
+            for (const auto& ap : attach) {
+                fillPolygon(p, ap.first.constData(), int(ap.first.size()), ap.second);
             }
-            fillPolygon(p, norm, ap.second);
         }
+        m_flip.drawWorldPopups(p, m_cameraX, m_cameraY, level_index);
     }
-    m_flip.drawWorldPopups(p, m_cameraX, m_cameraY, level_index);
 
     p.restore();
 
-    drawHUDFuel(p);
-    drawHUDCoins(p);
-    m_nitroSys.drawHUD(p, m_elapsedSeconds, level_index);
-    m_flip.drawHUD(p, level_index);
-    drawHUDDistance(p);
-    drawHUDScore(p);
-    m_keylog.draw(p, width(), height(), Constants::PIXEL_SIZE);
+    {
+        PERF_SCOPE(Hud);
+        drawHUD(p);
+        m_keylog.draw(p, width(), height(), Constants::PIXEL_SIZE);
+    }
+    m_telemetry.setRenderMs(float((m_telemetry.nowNs() - paintStartNs) / 1e6));
+    // Paints while the game is stopped (under the pause overlay) are not frames.
+    if (m_timer && m_timer->isActive()) Perf::endFrame();
+    else Perf::resetFrameClock();
+
+    if (m_showPerf) m_perfOverlay.draw(p, width() - Perf::Overlay::WIDTH - 8, 8);
+}
+
+void MainWindow::renderWorldBand(QPainter& p, const FrameBands::Pixels& px) const {
+    {
+        PERF_SCOPE(Sky);
+        drawStars(p, px.gy0, px.gy1);
+        drawClouds(p, px.gy0, px.gy1);
+    }
+    {
+        PERF_SCOPE(FilledTerrain);
+        drawFilledTerrain(px);
+    }
 }
 
 void MainWindow::updateCamera(double tx, double ty, double dt) {
@@ -431,72 +530,44 @@ void MainWindow::drawGridOverlay(QPainter& p) {
     p.restore();
 }
 
-void MainWindow::plotGridPixel(QPainter& p, int gx, int gy, const QColor& c) {
+void MainWindow::plotGridPixel(QPainter& p, int gx, int gy, const QColor& c) const {
     if (gx < 0 || gy < 0 || gx >= gridW() + 1 || gy >= gridH() + 1) return;
     p.fillRect(gx * Constants::PIXEL_SIZE, gy * Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, c);
 }
 
-void MainWindow::drawCircleFilledMidpointGrid(QPainter& p, int gcx, int gcy, int gr, const QColor& c)
+void MainWindow::startSpriteWarmup()
 {
-    int x = 0;
-    int y = gr;
-    int d = 1 - gr;
-    auto span = [&](int cy, int xl, int xr) { for (int xg = xl; xg <= xr; ++xg) plotGridPixel(p, xg, cy, c); };
-    while (y >= x) {
-        span(gcy + y, gcx - x, gcx + x);
-        span(gcy - y, gcx - x, gcx + x);
-        span(gcy + x, gcx - y, gcx + y);
-        span(gcy - x, gcx - y, gcx + y);
-        ++x;
-        if (d < 0) d += 2 * x + 1;
-        else { --y; d += 2 * (x - y) + 1; }
+    if (!Constants::CAR_SPRITE_PREWARM || Constants::CAR_SPRITE_BUCKETS <= 0) { assetReady(); return; }
+    if (!m_spriteWarmTimer) {
+        m_spriteWarmTimer = new QTimer(this);
+        connect(m_spriteWarmTimer, &QTimer::timeout, this, [this]{
+            // A few buckets per tick keeps the intro animating; whatever is left
+            // when a run starts gets built lazily on first use, and the sprites
+            // only count as ready once a later warmup finishes them.
+            if (!m_intro) {
+                m_spriteWarmTimer->stop();
+                StartupTrace::mark("sprite warmup interrupted");
+            } else if (m_carSprites.prewarm(8)) {
+                m_spriteWarmTimer->stop();
+                assetReady();
+            }
+        });
     }
+    m_spriteWarmTimer->start(15);
 }
 
-void MainWindow::fillPolygon(QPainter& p, QVector<QPoint> points, const QColor& c)
+void MainWindow::fillPolygon(QPainter& p, const QPoint* points, int count, const QColor& c)
 {
-    if (points.size() < 3) return;
-
-    struct EdgeEntry { int y_max; double x_at_min; double inv_slope; EdgeEntry(int ymax, double x_min, double inv_s) : y_max(ymax), x_at_min(x_min), inv_slope(inv_s) {} };
-    struct ActiveEdge { int y_max; double x_curr; double inv_slope; ActiveEdge(const EdgeEntry& e) : y_max(e.y_max), x_curr(e.x_at_min), inv_slope(e.inv_slope) {} bool operator<(const ActiveEdge& other) const { return x_curr < other.x_curr; } };
-
-    std::map<int, std::list<EdgeEntry>> edgeTable;
-    int global_y_min = std::numeric_limits<int>::max();
-    int global_y_max = std::numeric_limits<int>::min();
-
-    for (int i = 0; i < points.size(); ++i) {
-        const QPoint& p1 = points[i];
-        const QPoint& p2 = points[(i + 1) % points.size()];
-
-        global_y_min = std::min({global_y_min, p1.y(), p2.y()});
-        global_y_max = std::max({global_y_max, p1.y(), p2.y()});
-
-        const QPoint *v1 = &p1, *v2 = &p2;
-        if (v1->y() > v2->y()) std::swap(v1, v2);
-        if (v1->y() == v2->y()) continue;
-
-        double invSlope = static_cast<double>(v2->x() - v1->x()) / (v2->y() - v1->y());
-        edgeTable[v1->y()].emplace_back(v2->y(), v1->x(), invSlope);
-    }
-
-    std::list<ActiveEdge> activeEdgeTable;
-
-    for (int y = global_y_min; y < global_y_max; ++y) {
-        if (edgeTable.count(y)) for (const auto& edge : edgeTable[y]) activeEdgeTable.emplace_back(edge);
-        activeEdgeTable.remove_if([y](const ActiveEdge& e){ return e.y_max == y; });
-        activeEdgeTable.sort();
-
-        for (auto it = activeEdgeTable.begin(); it != activeEdgeTable.end(); it++) {
-            auto it_next = std::next(it);
-            if (it_next == activeEdgeTable.end()) break;
-            int x_start = static_cast<int>(std::ceil(it->x_curr));
-            int x_end = static_cast<int>(std::floor(it_next->x_curr));
-            for (int xg = x_start; xg <= x_end; ++xg) plotGridPixel(p, xg, y, c);
-            ++it;
-        }
-
-        for (auto& edge : activeEdgeTable) edge.x_curr += edge.inv_slope;
-    }
+    const int maxX = gridW();
+    const int maxY = gridH();
+    m_polyFiller.fill(points, count, Constants::PIXEL_SIZE, [&](int y, int xStart, int xEnd) {
+        if (y < 0 || y > maxY) return;
+        xStart = std::max(xStart, 0);
+        xEnd   = std::min(xEnd, maxX);
+        if (xStart > xEnd) return;
+        p.fillRect(xStart * Constants::PIXEL_SIZE, y * Constants::PIXEL_SIZE,
+                   (xEnd - xStart + 1) * Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, c);
+    });
 }
 
 void MainWindow::rasterizeSegmentToHeightMapWorld(int x1,int y1,int x2,int y2){
@@ -508,6 +579,7 @@ void MainWindow::rasterizeSegmentToHeightMapWorld(int x1,int y1,int x2,int y2){
     if (x2 == x1) {
         const int gy = static_cast<int>(std::floor(y1 / double(Constants::PIXEL_SIZE) + 0.5));
         m_heightAtGX.insert(gx1, gy);
+        m_materials.addColumn(gx1, gy);
         return;
     }
 
@@ -523,6 +595,7 @@ void MainWindow::rasterizeSegmentToHeightMapWorld(int x1,int y1,int x2,int y2){
         const int gy = static_cast<int>(std::floor(wy / double(Constants::PIXEL_SIZE) + 0.5));
 
         m_heightAtGX.insert(gx, gy);
+        m_materials.addColumn(gx, gy);
     }
 }
 
@@ -537,6 +610,7 @@ void MainWindow::pruneHeightMap() {
         if (it.key() < keepFromGX) toRemove.append(it.key());
     }
     for (int k : toRemove) m_heightAtGX.remove(k);
+    m_materials.prune(keepFromGX);
 }
 
 void MainWindow::keyPressEvent(QKeyEvent *event) {
@@ -545,7 +619,7 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
     switch (event->key()) {
     case Qt::Key_D:
     case Qt::Key_Right:
-        if (!m_accelerating) m_media->startAccelLoop();
+        if (!m_accelerating && m_media) m_media->startAccelLoop();
         m_accelerating = true;
         m_keylog.setPressed(Qt::Key_D, true);
         break;
@@ -558,7 +632,7 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
 
     case Qt::Key_W:
     case Qt::Key_Up:
-        m_media->playNitroOnce();
+        if (m_media) m_media->playNitroOnce();
         m_nitroKey = true;
         m_keylog.setPressed(Qt::Key_W, true);
         break;
@@ -567,9 +641,22 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
         m_showGrid = !m_showGrid;
         break;
 
+    case Qt::Key_F3:
+        m_showPerf = !m_showPerf;
+        break;
+
+    case Qt::Key_F8:
+        dumpTelemetry();
+        break;
+
+    case Qt::Key_F9:
+        Trace::write("manual");
+        break;
+
     case Qt::Key_P:
         if (!m_intro && !m_outro && m_timer && m_timer->isActive()) {
             m_timer->stop();
+            Perf::resetFrameClock();
             if (m_pause) {
                 m_pause->setLevelIndex(level_index);
                 m_pause->showPaused();
@@ -584,6 +671,7 @@ void MainWindow::keyPressEvent(QKeyEvent *event) {
         if (m_leaderboardWidget && m_leaderboardMgr) {
             if (m_timer && m_timer->isActive()) {
                 m_timer->stop(); // pause game while viewing leaderboard
+                Perf::resetFrameClock();
             }
             m_leaderboardWidget->setGeometry(rect());
             m_leaderboardWidget->show();
@@ -605,7 +693,7 @@ void MainWindow::keyReleaseEvent(QKeyEvent *event) {
     case Qt::Key_Right:
         m_accelerating = false;
         m_keylog.setPressed(Qt::Key_D, false);
-        m_media->stopAccelLoop();
+        if (m_media) m_media->stopAccelLoop();
         break;
     case Qt::Key_A:
     case Qt::Key_Left:
@@ -649,7 +737,13 @@ void MainWindow::ensureAheadTerrain(int worldX) {
         m_lastY = newY;
         m_lastX += Constants::STEP;
 
-        if (m_lines.size() > (width() / Constants::STEP) * 3) { m_lines.removeFirst(); pruneHeightMap(); }
+        if (m_lines.size() > (width() / Constants::STEP) * 3) {
+            m_lines.removeFirst();
+            pruneHeightMap();
+            m_coinSys.prune(leftmostTerrainX());
+            m_fuelSys.prune(leftmostTerrainX());
+            m_propSys.prune(leftmostTerrainX());
+        }
 
         // UPDATED: Access increments via LEVELS
         m_difficulty += Constants::LEVELS[level_index].difficultyIncrement;
@@ -699,7 +793,7 @@ void MainWindow::maybeSpawnCloud() {
     }
 }
 
-void MainWindow::drawClouds(QPainter& p) {
+void MainWindow::drawClouds(QPainter& p, int gy0, int gy1) const {
     // UPDATED: Access probability via LEVELS
     if (Constants::LEVELS[level_index].cloudProbability <= 0.001) return;
 
@@ -710,11 +804,16 @@ void MainWindow::drawClouds(QPainter& p) {
         p.fillRect(gx * Constants::PIXEL_SIZE, gy * Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, c);
     };
 
+    const QColor cMain = Constants::LEVELS[level_index].cloudColor;
+    const QColor cSoft(cMain.red()*0.9, cMain.green()*0.9, cMain.blue()*0.9);
+
     for (const Cloud& cl : m_clouds) {
         int baseGX = (cl.wx / Constants::PIXEL_SIZE) - camGX;
         int baseGY = cl.wyCells + camGY;
+        if (baseGY >= gy1 || baseGY + cl.hCells <= gy0) continue;
 
-        for (int yy = 0; yy < cl.hCells; ++yy) {
+        const int yyEnd = std::min(cl.hCells, gy1 - baseGY);
+        for (int yy = std::max(0, gy0 - baseGY); yy < yyEnd; ++yy) {
             for (int xx = 0; xx < cl.wCells; ++xx) {
                 double nx = ((xx + 0.5) - cl.wCells  / 2.0) / (cl.wCells  / 2.0);
                 double ny = ((yy + 0.5) - cl.hCells / 2.0) / (cl.hCells / 2.0);
@@ -724,10 +823,7 @@ void MainWindow::drawClouds(QPainter& p) {
                 double fuzz = (h % 100) / 400.0;
 
                 if (r2 <= 1.0 + fuzz) {
-                    // UPDATED: Access cloudColor via LEVELS
-                    QColor cMain = Constants::LEVELS[level_index].cloudColor;
-                    QColor cSoft(cMain.red()*0.9,cMain.green()*0.9,cMain.blue()*0.9);
-                    QColor pix = ((h >> 3) & 1) ? cMain : cSoft;
+                    const QColor& pix = ((h >> 3) & 1) ? cMain : cSoft;
                     plotGridPixelLocal(baseGX + xx, baseGY + yy, pix);
                 }
             }
@@ -735,117 +831,153 @@ void MainWindow::drawClouds(QPainter& p) {
     }
 }
 
-void MainWindow::drawStars(QPainter& p) {
+void MainWindow::prepareStars() {
     // UPDATED: Access starProbability via LEVELS
     if (Constants::LEVELS[level_index].starProbability <= 0.001) return;
 
-    const int BLOCK = 20;
     const int camGX = m_cameraX / Constants::PIXEL_SIZE;
     const int camGY = m_cameraY / Constants::PIXEL_SIZE;
 
-    const int startBX = (camGX) / BLOCK - 1;
-    const int endBX   = (camGX + gridW()) / BLOCK + 1;
-    const int startBY = (-camGY) / BLOCK - 1;
-    const int endBY   = (-camGY + gridH()) / BLOCK + 1;
-
-    for (int bx = startBX; bx <= endBX; ++bx) {
-        for (int by = startBY; by <= endBY; ++by) {
-            quint32 h = hash2D(bx, by);
-            std::mt19937 rng(h);
-            std::uniform_real_distribution<float> fdist(0.0f, 1.0f);
-
-            // UPDATED: Access starProbability via LEVELS
-            if (fdist(rng) < Constants::LEVELS[level_index].starProbability * 0.4) {
-                std::uniform_int_distribution<int> idist(0, BLOCK - 1);
-                int wgx = bx * BLOCK + idist(rng);
-                int wgy = by * BLOCK + idist(rng);
-
-                int groundGy = groundGyNearestGX(wgx);
-                if (groundGy == 0 && !m_heightAtGX.contains(wgx)) groundGy = 10000;
-
-                if (wgy < groundGy - 8) {
-                    int sgx = wgx - camGX;
-                    int sgy = wgy + camGY;
-                    int alpha = std::uniform_int_distribution<int>(100, 255)(rng);
-                    plotGridPixel(p, sgx, sgy, QColor(255, 255, 255, alpha));
-                }
-            }
-        }
-    }
+    m_starField.setDensity(Constants::LEVELS[level_index].starProbability * 0.4);
+    m_starField.prepare(camGX, -camGY, camGX + gridW(), -camGY + gridH());
 }
 
-void MainWindow::drawFilledTerrain(QPainter& p) {
+void MainWindow::drawStars(QPainter& p, int gy0, int gy1) const {
+    if (Constants::LEVELS[level_index].starProbability <= 0.001) return;
+
     const int camGX = m_cameraX / Constants::PIXEL_SIZE;
     const int camGY = m_cameraY / Constants::PIXEL_SIZE;
 
-    for (int sgx = 0; sgx <= gridW(); ++sgx) {
+    m_starField.forEachVisible([&](const StarField::Star& s) {
+        const int sgy = s.wgy + camGY;
+        if (sgy < gy0 || sgy >= gy1) return;
+        const int sgx = s.wgx - camGX;
+        if (sgx < 0 || sgx >= m_groundColumns.size()) return;
+        if (s.wgy >= m_groundColumns[sgx] - 8) return;
+        plotGridPixel(p, sgx, sgy, QColor(255, 255, 255, s.alpha));
+    });
+}
+
+void MainWindow::updateGroundColumns() {
+    const int camGX = m_cameraX / Constants::PIXEL_SIZE;
+    const int camGY = m_cameraY / Constants::PIXEL_SIZE;
+    const int cols = gridW() + 1;
+    m_groundColumns.resize(cols);
+    m_terrainSurface.resize(cols);
+    m_terrainStart.resize(cols);
+    m_terrainStripe.resize(cols);
+    m_materialColumns.resize(cols);
+    m_materialBX.resize(cols);
+    m_terrainTop = TerrainRow::NO_SURFACE;
+
+    for (int sgx = 0; sgx < cols; ++sgx) {
         const int worldGX = sgx + camGX;
         auto it = m_heightAtGX.constFind(worldGX);
-        if (it == m_heightAtGX.constEnd()) continue;
-
-        const int groundWorldGY = it.value();
-        int startScreenGY = groundWorldGY + camGY;
-        if (startScreenGY < 0) startScreenGY = 0;
-        if (startScreenGY >= gridH()) continue;
-
-        for (int sGY = startScreenGY; sGY <= gridH(); ++sGY) {
-            const int worldGY = sGY - camGY;
-            int depth = sGY - startScreenGY; // 0 is the top surface
-
-            // === HIGHWAY LOGIC (Level 5) ===
-            if (level_index == 5) {
-                QColor c;
-                // The road is the top 14 pixels of the terrain
-                if (depth < 14) {
-                    // 1. Top Edge Highlight (Lighter gray)
-                    if (depth == 0) {
-                        c = QColor(80, 80, 85);
-                    }
-                    // 2. Yellow Dashed Line (Middle of road)
-                    // Depth 6-7 is the vertical position.
-                    // (worldGX % 20 < 10) creates the horizontal dash pattern.
-                    else if (depth >= 6 && depth <= 7 && (worldGX % 20 < 10)) {
-                        c = QColor(240, 190, 40); // Highway Yellow
-                    }
-                    // 3. Asphalt Body (Dark Gray)
-                    else {
-                        c = QColor(50, 50, 55);
-                    }
-                    plotGridPixel(p, sgx, sGY, c);
-                    continue; // Skip standard palette logic
-                }
-            }
-            // ===============================
-
-            bool topZone = (sGY < groundWorldGY + camGY + 3*Constants::SHADING_BLOCK);
-            const QColor shade = grassShadeForBlock(worldGX, worldGY, topZone);
-            plotGridPixel(p, sgx, sGY, shade);
+        const int ground = (it == m_heightAtGX.constEnd()) ? NO_GROUND : it.value();
+        m_groundColumns[sgx] = ground;
+
+        qint32 surface = TerrainRow::NO_SURFACE;
+        qint32 start = TerrainRow::NO_SURFACE;
+        if (ground != NO_GROUND) {
+            surface = ground + camGY;
+            start = std::max(surface, 0);
+            // Columns whose terrain starts at or below the bottom row are not drawn.
+            if (start >= gridH()) surface = start = TerrainRow::NO_SURFACE;
         }
+        m_terrainSurface[sgx] = surface;
+        m_terrainStart[sgx] = start;
+        m_terrainTop = std::min(m_terrainTop, start);
+        m_terrainStripe[sgx] = (worldGX % 20 < 10) ? 1 : 0;
+        m_materialBX[sgx] = worldGX / Constants::SHADING_BLOCK;
+        m_materialColumns[sgx] = m_materials.column(m_materialBX[sgx]);
+    }
+}
 
-        // Draw the top edge pixel (only for non-highway levels)
-        if (level_index != 5) {
-            const QColor edge = grassShadeForBlock(worldGX, groundWorldGY, true).darker(115);
-            plotGridPixel(p, sgx, groundWorldGY + camGY, edge);
+void MainWindow::drawFilledTerrain(const FrameBands::Pixels& px) const {
+    const int camGY = m_cameraY / Constants::PIXEL_SIZE;
+    const int columns = std::min(int(m_terrainStart.size()), px.width);
+    const int rowEnd  = std::min(gridH(), px.gy1 - 1);
+
+    TerrainRow r;
+    r.surface  = m_terrainSurface.constData();
+    r.start    = m_terrainStart.constData();
+    r.stripe   = m_terrainStripe.constData();
+    r.grassLut = m_materials.grassTable();
+    r.dirtLut  = m_materials.dirtTable();
+    r.edgeLut  = m_materials.edgeTable();
+    r.columns  = columns;
+
+    // Material bytes of the shading-block row the current screen row falls in;
+    // consecutive rows share it, so it is only rebuilt when the block changes.
+    thread_local QVector<quint8> materialRow;
+    materialRow.resize(columns);
+    int rowBY = std::numeric_limits<int>::min();
+
+    for (int sGY = std::max({px.gy0, m_terrainTop, 0}); sGY <= rowEnd; ++sGY) {
+        const int by = (sGY - camGY) / Constants::SHADING_BLOCK;
+        if (by != rowBY) {
+            for (int sgx = 0; sgx < columns; ++sgx) {
+                const auto* col = m_materialColumns[sgx];
+                materialRow[sgx] = (m_terrainStart[sgx] == TerrainRow::NO_SURFACE)
+                    ? 0 : m_materials.material(col, m_materialBX[sgx], by);
+            }
+            rowBY = by;
         }
+        r.row = sGY;
+        r.material = materialRow.constData();
+        m_stage->shadeTerrain(r, px.row(sGY));
     }
 }
 
-QColor MainWindow::grassShadeForBlock(int worldGX, int worldGY, bool greenify) const {
-    const int bx = worldGX / Constants::SHADING_BLOCK;
-    const int by = worldGY / Constants::SHADING_BLOCK;
-    const quint32 h = hash2D(bx, by);
+MainWindow::HudState MainWindow::currentHudState() const {
+    HudState s;
+    s.width  = width();
+    s.height = height();
+    s.level  = level_index;
+    s.coins  = m_coinCount;
+    s.score  = m_score;
+    s.distanceTenths = qint64(std::llround(m_totalDistanceCells * Constants::PIXEL_SIZE / 10.0));
+    s.fuelCells = hudFuelCells();
+    s.lowFuelFlash = lowFuelFlashOn();
+    s.nitroSeconds = m_nitroSys.hudCountdown(m_elapsedSeconds);
+    s.flips = m_flip.total();
+    return s;
+}
 
-    if (greenify) {
-        // UPDATED: Access palette via LEVELS, and use size() correctly
-        const auto& pal = Constants::LEVELS[level_index].grassPalette;
-        const int idxG = int(h % pal.size());
-        return pal[idxG];
-    } else {
-        // UPDATED: Access palette via LEVELS
-        const auto& pal = Constants::LEVELS[level_index].dirtPalette;
-        const int idxD = int(h % pal.size());
-        return pal[idxD];
+void MainWindow::drawHUD(QPainter& p) {
+    const HudState s = currentHudState();
+    const qreal dpr = devicePixelRatioF();
+
+    if (!m_hudValid || !(s == m_hudState) || m_hudImage.devicePixelRatio() != dpr) {
+        const QSize px(int(std::ceil(s.width * dpr)), int(std::ceil(s.height * dpr)));
+        if (m_hudImage.size() != px) m_hudImage = QImage(px, QImage::Format_ARGB32_Premultiplied);
+        m_hudImage.setDevicePixelRatio(dpr);
+        m_hudImage.fill(Qt::transparent);
+
+        QPainter hp(&m_hudImage);
+        hp.setRenderHint(QPainter::Antialiasing, true);
+        hp.setPen(Qt::NoPen);
+        drawHUDFuel(hp);
+        drawHUDCoins(hp);
+        m_nitroSys.drawHUD(hp, m_elapsedSeconds, level_index);
+        m_flip.drawHUD(hp, level_index);
+        drawHUDDistance(hp);
+        drawHUDScore(hp);
+
+        m_hudState = s;
+        m_hudValid = true;
     }
+    p.drawImage(0, 0, m_hudImage);
+}
+
+bool MainWindow::lowFuelFlashOn() const {
+    return m_fuel <= Constants::FUEL_MAX * 0.25 && std::fmod(m_elapsedSeconds, 1.0) < 0.5;
+}
+
+int MainWindow::hudFuelCells() const {
+    const int wcells = std::min(std::max(gridW()/4, 24), 48);
+    const double frac = std::clamp(m_fuel / Constants::FUEL_MAX, 0.0, 1.0);
+    return int(std::floor(wcells * frac));
 }
 
 void MainWindow::drawHUDFuel(QPainter& p) {
@@ -854,8 +986,7 @@ void MainWindow::drawHUDFuel(QPainter& p) {
     int gx = (gridW() - wcells)/2;
     int barH = 3;
 
-    double frac = std::clamp(m_fuel / Constants::FUEL_MAX, 0.0, 1.0);
-    int filled = int(std::floor(wcells * frac));
+    int filled = hudFuelCells();
 
     auto lerp = [](const QColor& c1, const QColor& c2, double t)->QColor {
         int r = int((1-t)*c1.red()   + t*c2.red());
@@ -891,12 +1022,7 @@ void MainWindow::drawHUDFuel(QPainter& p) {
 
     for (int x=tickEvery; x<wcells; x+=tickEvery)
         plotGridPixel(p, gx+x, gy+barH, QColor(80,80,70));
-    const double lowFuelThreshold = Constants::FUEL_MAX * 0.25;
-
-    const bool isLow = (m_fuel <= lowFuelThreshold);
-    const bool isFlashingOn = (std::fmod(m_elapsedSeconds, 1.0) < 0.5);
-
-    if (isLow && isFlashingOn) {
+    if (lowFuelFlashOn()) {
         const QColor red(230, 50, 40);
         const QColor white(255, 255, 255);
         const int warningGap = 3;
@@ -952,51 +1078,46 @@ void MainWindow::drawHUDFuel(QPainter& p) {
 void MainWindow::drawHUDCoins(QPainter& p) {
     int iconGX = Constants::HUD_LEFT_MARGIN + Constants::COIN_RADIUS_CELLS + 1;
     int iconGY = Constants::HUD_TOP_MARGIN  + Constants::COIN_RADIUS_CELLS;
-    drawCircleFilledMidpointGrid(p, iconGX, iconGY, Constants::COIN_RADIUS_CELLS, QColor(195,140,40));
-    drawCircleFilledMidpointGrid(p, iconGX, iconGY, std::max(1, Constants::COIN_RADIUS_CELLS-1), QColor(250,204,77));
+    CircleSpans::drawRings(p, iconGX, iconGY, {{Constants::COIN_RADIUS_CELLS, QColor(195,140,40)},
+                                               {std::max(1, Constants::COIN_RADIUS_CELLS-1), QColor(250,204,77)}},
+                           QRect(0, 0, gridW() + 1, gridH() + 1));
     plotGridPixel(p, iconGX-1, iconGY-Constants::COIN_RADIUS_CELLS+1, QColor(255,255,220));
-    QFont f; f.setFamily("Monospace"); f.setBold(true); f.setPointSize(12);
-    p.setFont(f);
 
     // UPDATED: Access textColor via LEVELS
     p.setPen(Constants::LEVELS[level_index].textColor);
 
     int px = (Constants::HUD_LEFT_MARGIN + Constants::COIN_RADIUS_CELLS*2 + 3) * Constants::PIXEL_SIZE;
     int py = (Constants::HUD_TOP_MARGIN  + Constants::COIN_RADIUS_CELLS + 2) * Constants::PIXEL_SIZE;
-    p.drawText(px, py, QString::number(m_coinCount));
+    HudText::draw(p, px, py, QString::number(m_coinCount));
 }
 
 void MainWindow::drawHUDDistance(QPainter& p) {
     double meters = (m_totalDistanceCells * Constants::PIXEL_SIZE) / 100.0;
     QString s = QString::number(meters, 'f', 1) + " m";
-    QFont f; f.setFamily("Monospace"); f.setBold(true); f.setPointSize(12);
-    p.setFont(f);
 
     // UPDATED: Access textColor via LEVELS
     p.setPen(Constants::LEVELS[level_index].textColor);
 
-    QFontMetrics fm(f);
+    const QFontMetrics& fm = HudText::metrics();
     int px = width() - fm.horizontalAdvance(s) - 12;
     int py = (Constants::HUD_TOP_MARGIN + Constants::COIN_RADIUS_CELLS + 2) * Constants::PIXEL_SIZE;
-    p.drawText(px, py, s);
+    HudText::draw(p, px, py, s);
 }
 
 
 void MainWindow::drawHUDScore(QPainter& p) {
     const QString s = QString::number(m_score);
-    QFont f; f.setFamily("Monospace"); f.setBold(true); f.setPointSize(12);
-    p.setFont(f);
 
     // UPDATED: Access textColor via LEVELS
     p.setPen(Constants::LEVELS[level_index].textColor);
 
-    QFontMetrics fm(f);
+    const QFontMetrics& fm = HudText::metrics();
     const int rightPadPx = 12;
     const int px = width() - fm.horizontalAdvance(s) - rightPadPx;
     const int distancePy = (Constants::HUD_TOP_MARGIN + Constants::COIN_RADIUS_CELLS + 2) * Constants::PIXEL_SIZE;
     const int gapPx = 8;
     const int py = distancePy - fm.height() - gapPx;
-    p.drawText(px, py, s);
+    HudText::draw(p, px, py, s);
 }
 
 
@@ -1023,16 +1144,22 @@ double MainWindow::terrainTangentAngleAtX(double wx) const {
 
 void MainWindow::showGameOver() {
     if (m_media) m_media->playGameOverOnce();
-    if (m_leaderboardMgr) {
-        QString stageName = QStringLiteral("UNKNOWN");
-        // UPDATED: Access name via LEVELS
-        if (level_index >= 0 && level_index < Constants::LEVELS.size()) {
-            stageName = Constants::LEVELS[level_index].name;
-        }
-        m_leaderboardMgr->submitScore(stageName, m_score);
+    if (m_leaderboardMgr && level_index >= 0 && level_index < Constants::LEVEL_COUNT) {
+        RunRecord run;
+        run.endedAtMs  = QDateTime::currentMSecsSinceEpoch();
+        run.seed       = m_runSeed;
+        run.score      = m_score;
+        run.distanceDm = qint32(std::llround(m_totalDistanceCells * Constants::PIXEL_SIZE / 10.0));
+        run.durationMs = quint32(std::llround(m_elapsedSeconds * 1000.0));
+        run.coins      = m_coinCount;
+        run.flips      = qint16(std::min(m_flip.total(), int(std::numeric_limits<qint16>::max())));
+        run.nitroUses  = qint16(std::min(m_nitroUses, int(std::numeric_limits<qint16>::max())));
+        run.stage      = quint8(level_index);
+        m_leaderboardMgr->submitRun(run);
     }
     if (m_outro) return;
     if (m_timer) m_timer->stop();
+    Perf::resetFrameClock();
 
     m_outro = new OutroScreen(this);
     m_outro->setStats(m_coinCount, m_nitroUses, m_score, (m_totalDistanceCells * Constants::PIXEL_SIZE) / 100.0);
@@ -1070,6 +1197,7 @@ void MainWindow::returnToIntro() {
     m_roofCrashLatched = false;
 
     if (m_timer) m_timer->stop();
+    Perf::resetFrameClock();
 
     m_grandTotalCoins += m_coinCount;
     saveGrandCoins();
@@ -1087,6 +1215,9 @@ void MainWindow::returnToIntro() {
     m_intro->setGeometry(rect());
     m_intro->setGrandCoins(m_grandTotalCoins);
     m_intro->show();
+    startSpriteWarmup();
+    connectIntroAudio();
+    if (m_media) m_media->prefetchStageBgm(level_index);
 
     connect(m_intro, &IntroScreen::exitRequested, this, &QWidget::close);
     connect(m_intro, &IntroScreen::startRequested, this, [this](int levelIndex){
@@ -1166,6 +1297,10 @@ void MainWindow::resetGameRound() {
     m_roofCrashLatched  = false;
     ++m_sessionId;
 
+    // A fresh seed per round, recorded with the run in the run log.
+    m_runSeed = std::random_device{}();
+    m_rng.seed(m_runSeed);
+
     m_nitroSys = NitroSystem();
     m_fuelSys  = FuelSystem();
     m_coinSys  = CoinSystem();
@@ -1180,6 +1315,8 @@ void MainWindow::resetGameRound() {
 
     m_lines.clear();
     m_heightAtGX.clear();
+    m_materials.setLevel(Constants::LEVELS[level_index]);
+    m_stage = &StagePaths::forLevel(level_index);
     m_lastX = 0;
     m_lastY = 0;
     m_slope = 0;
@@ -1216,17 +1353,16 @@ void MainWindow::resetGameRound() {
 }
 
 void MainWindow::saveGrandCoins() const {
-    QSettings s("JU","F1PixelGrid");
-    s.setValue("grandCoins", m_grandTotalCoins);
-    s.sync();
+    ProfileStore::instance().setGrandCoins(m_grandTotalCoins);
 }
 
 void MainWindow::loadGrandCoins() {
-    QSettings s("JU","F1PixelGrid");
-    m_grandTotalCoins = s.value("grandCoins", 0).toInt();
+    m_grandTotalCoins = int(ProfileStore::instance().grandCoins());
 }
 
 void MainWindow::closeEvent(QCloseEvent* e) {
-    saveGrandCoins();
+    // Closing before the deferred load must not overwrite the stored total.
+    if (m_deferredLoaded) saveGrandCoins();
+    ProfileStore::instance().flush();
     QWidget::closeEvent(e);
 }
@@ -9,7 +9,9 @@
 #include <QHash>
 #include <QColor>
 #include <QElapsedTimer>
+#include <QImage>
 #include <random>
+#include <limits>
 
 #include "media.h"
 #include "constants.h"
@@ -25,6 +27,15 @@
 #include "pause.h"
 #include "prop.h"
 #include "scoreboard.h"
+#include "starfield.h"
+#include "polyfill.h"
+#include "carsprite.h"
+#include "framebands.h"
+#include "terrainmaterial.h"
+#include "terrainkernel.h"
+#include "stagepaths.h"
+#include "telemetry.h"
+#include "perfprobe.h"
 
 class QKeyEvent;
 class QPainter;
@@ -45,9 +56,13 @@ protected:
 
 private slots:
     void gameLoop();
+    void loadDeferredAssets();
 
 private:
     KeyLog m_keylog;
+    Telemetry m_telemetry;
+    void recordTelemetry(qint64 dtNs, qint64 tickStartNs);
+    void dumpTelemetry();
     Media* m_media = nullptr;
     bool m_suppressFuelSfx = false;
     void generateInitialTerrain();
@@ -55,23 +70,52 @@ private:
     void drawGridOverlay(QPainter& p);
     inline int gridW() const { return width()  / Constants::PIXEL_SIZE; }
     inline int gridH() const { return height() / Constants::PIXEL_SIZE; }
-    void plotGridPixel(QPainter& p, int gx, int gy, const QColor& c);
-    void drawCircleFilledMidpointGrid(QPainter& p, int gcx, int gcy, int gr, const QColor& c);
-    void fillPolygon(QPainter& p, QVector<QPoint> points, const QColor& c);
-    void drawFilledTerrain(QPainter& p);
+    void plotGridPixel(QPainter& p, int gx, int gy, const QColor& c) const;
+    void fillPolygon(QPainter& p, const QPoint* points, int count, const QColor& c);
+    void drawFilledTerrain(const FrameBands::Pixels& px) const;
+
+    // World layers (stars, clouds, terrain) for the band's screen rows;
+    // `p` draws in grid-pixel coordinates. Called from the frame band workers,
+    // so it must only read state.
+    void renderWorldBand(QPainter& p, const FrameBands::Pixels& px) const;
+    FrameBands m_frameBands;
 
     void drawHUDFuel(QPainter& p);
     void drawHUDCoins(QPainter& p);
     void drawHUDDistance(QPainter& p);
     void drawHUDScore(QPainter& p);
 
-    QColor grassShadeForBlock(int worldGX, int worldGY, bool greenify) const;
-    static inline quint32 hash2D(int x, int y) {
-        quint32 h = 120003212u;
-        h ^= quint32(x); h *= 16777619u;
-        h ^= quint32(y); h *= 16777619u;
-        return (h ^ x) / (h ^ y) + (x * y) - (3 * x*x + 4 * y*y);
-    }
+    // Everything the HUD overlay shows; the cached image is redrawn only when
+    // one of these changes.
+    struct HudState {
+        int width = 0, height = 0, level = 0;
+        int coins = 0, score = 0;
+        qint64 distanceTenths = 0;
+        int fuelCells = 0;
+        bool lowFuelFlash = false;
+        int nitroSeconds = 0;
+        int flips = 0;
+        bool operator==(const HudState& o) const {
+            return width == o.width && height == o.height && level == o.level
+                && coins == o.coins && score == o.score && distanceTenths == o.distanceTenths
+                && fuelCells == o.fuelCells && lowFuelFlash == o.lowFuelFlash
+                && nitroSeconds == o.nitroSeconds && flips == o.flips;
+        }
+    };
+    HudState currentHudState() const;
+    int hudFuelCells() const;
+    // The low-fuel warning is showing: fuel at a quarter or less, lit for the
+    // first half of every second.
+    bool lowFuelFlashOn() const;
+    void drawHUD(QPainter& p);
+    QImage m_hudImage;
+    HudState m_hudState;
+    bool m_hudValid = false;
+
+    TerrainMaterialCache m_materials;
+    // Physics step and terrain shader specialized for the current stage.
+    const StagePaths* m_stage = &StagePaths::forLevel(0);
+    static inline quint32 hash2D(int x, int y) { return TerrainMaterialCache::hash(x, y); }
     void rasterizeSegmentToHeightMapWorld(int x1, int y1, int x2, int y2);
     void pruneHeightMap();
     void ensureAheadTerrain(int worldX);
@@ -106,6 +150,15 @@ private:
 
     void saveGrandCoins() const;
     void loadGrandCoins();
+
+    // Startup work that waits until the intro has painted its first frame.
+    // Each asset group calls assetReady() once; the last one ends the trace.
+    static constexpr int DEFERRED_ASSET_GROUPS = 2; // audio, car sprites
+    int m_assetsPending = DEFERRED_ASSET_GROUPS;
+    bool m_deferredLoaded = false;
+    void assetReady();
+    // Hooks the intro's level selector up to BGM prefetching.
+    void connectIntroAudio();
     LeaderboardManager* m_leaderboardMgr   = nullptr;
     LeaderboardWidget*  m_leaderboardWidget = nullptr;
 
@@ -133,9 +186,12 @@ private:
     bool m_nitroKey     = false;
 
     std::mt19937 m_rng;
+    quint32 m_runSeed = 0;
     std::uniform_real_distribution<float> m_dist;
 
     bool m_showGrid = false;
+    bool m_showPerf = false;
+    Perf::Overlay m_perfOverlay;
 
     QHash<int,int> m_heightAtGX;
     int leftmostTerrainX() const;
@@ -160,7 +216,7 @@ private:
     QVector<Cloud> m_clouds;
     int m_lastCloudSpawnX = 0;
     void maybeSpawnCloud();
-    void drawClouds(QPainter& p);
+    void drawClouds(QPainter& p, int gy0, int gy1) const;
 
     struct Star {
         int wx;
@@ -170,7 +226,25 @@ private:
 
     QVector<Star> m_stars;
     int m_lastStarSpawnX = 0;
-    void drawStars(QPainter& p);
+    StarField m_starField;
+    PolygonFiller m_polyFiller;
+    CarSpriteCache m_carSprites{Constants::CAR_SPRITE_BUCKETS, Constants::PIXEL_SIZE};
+    QTimer* m_spriteWarmTimer = nullptr;
+    void startSpriteWarmup();
+    void prepareStars();
+    void drawStars(QPainter& p, int gy0, int gy1) const;
+
+    // Ground height (world gy) of every on-screen column, rebuilt once per frame.
+    static constexpr int NO_GROUND = std::numeric_limits<int>::max();
+    QVector<int> m_groundColumns;
+    // Per-column inputs of the terrain row kernel, rebuilt alongside m_groundColumns.
+    QVector<qint32> m_terrainSurface;
+    QVector<qint32> m_terrainStart;
+    QVector<quint8> m_terrainStripe;
+    QVector<const TerrainMaterialCache::Column*> m_materialColumns;
+    QVector<int> m_materialBX;
+    int m_terrainTop = 0;
+    void updateGroundColumns();
 
 
     IntroScreen* m_intro = nullptr;
@@ -1,16 +1,19 @@
 #include "media.h"
+#include "audiomixer.h"
+#include "trace.h"
 
-#include <QAudioOutput>
-#include <QMediaPlayer>
-#include <QMediaDevices>
-#include <QSoundEffect>
-#include <QPropertyAnimation>
 #include <QCoreApplication>
 #include <QFile>
 #include <QUrl>
 
 namespace {
 
+// Mixer tags for the sounds that are restarted, faded or re-gained rather than overlapped
+enum SfxTag { AccelTag = 1, NitroTag = 2, BgmTag = 3, GameOverTag = 4 };
+
+constexpr float SFX_GAIN = 0.35f;
+constexpr int   BGM_CROSSFADE_MS = 600;
+
 // Try to load a stage-specific BGM either from qrc:/audio or from
 // applicationDirPath()/assets/audio
 QUrl pickBgmUrl(const QString& alias, const QString& fileName)
@@ -52,109 +55,9 @@ QUrl defaultBgmUrl()
     return {};
 }
 
-} // namespace
-
-Media::Media(QObject* parent)
-    : QObject(parent)
-{
-    // --- Driving / accelerate loop SFX ---
-    auto* e = new QSoundEffect(this);
-    e->setSource(QUrl(QStringLiteral("qrc:/sfx/accelerate.wav")));
-    e->setLoopCount(1);
-    e->setVolume(0.35);
-    m_driveSfx.push_back(e);
-
-    // --- Nitro SFX ---
-    m_nitroSfx = new QSoundEffect(this);
-    m_nitroSfx->setSource(QUrl(QStringLiteral("qrc:/sfx/nitro.wav")));
-    m_nitroSfx->setLoopCount(1);
-    m_nitroSfx->setVolume(0.35);
-
-    // --- Game over SFX ---
-    m_gameOverOut = new QAudioOutput(this);
-    m_gameOverOut->setVolume(0.35);
-    m_gameOver = new QMediaPlayer(this);
-    m_gameOver->setAudioOutput(m_gameOverOut);
-    m_gameOver->setSource(QUrl(QStringLiteral("qrc:/sfx/gameOver.mp3")));
-
-    // --- Coin SFX pool ---
-    const char* coinPath = "qrc:/sfx/coin.mp3";
-    for (int i = 0; i < 3; ++i) {
-        auto* out = new QAudioOutput(this);
-        out->setVolume(0.35);
-        auto* p = new QMediaPlayer(this);
-        p->setAudioOutput(out);
-        p->setSource(QUrl(coinPath));
-        m_coinOuts.push_back(out);
-        m_coinPlayers.push_back(p);
-    }
-
-    // --- Fuel SFX pool ---
-    const char* fuelPath = "qrc:/sfx/fuel.mp3";
-    for (int i = 0; i < 3; ++i) {
-        auto* out = new QAudioOutput(this);
-        out->setVolume(0.35);
-        auto* p = new QMediaPlayer(this);
-        p->setAudioOutput(out);
-        p->setSource(QUrl(fuelPath));
-        m_fuelOuts.push_back(out);
-        m_fuelPlayers.push_back(p);
-    }
-}
-
-Media::~Media() = default;
-
-// -----------------------------------------------------------------------------
-// Background music setup / control
-// -----------------------------------------------------------------------------
-void Media::setupBgm()
-{
-    // Output device for BGM
-    m_bgmOut = new QAudioOutput(this);
-    m_bgmOut->setVolume(1); // initial volume, you later override via setBgmVolume()
-
-    // Player for BGM
-    m_bgm = new QMediaPlayer(this);
-    m_bgm->setAudioOutput(m_bgmOut);
-    m_bgm->setLoops(QMediaPlayer::Infinite);
-
-    // Default source at startup (intro / menu)
-    const QUrl src = defaultBgmUrl();
-    if (!src.isEmpty()) {
-        m_bgm->setSource(src);
-    }
-}
-
-void Media::setBgmVolume(qreal v)
+// Stage track, or the default BGM if the stage has none
+QUrl stageBgmUrl(int levelIndex)
 {
-    if (m_bgmOut) {
-        m_bgmOut->setVolume(v);
-    }
-}
-
-void Media::playBgm()
-{
-    if (m_bgm) {
-        m_bgm->play();
-    }
-}
-
-void Media::stopBgm()
-{
-    if (m_bgm) {
-        m_bgm->stop();
-    }
-}
-
-// -----------------------------------------------------------------------------
-// Per-stage BGM (including NIGHTLIFE)
-// -----------------------------------------------------------------------------
-void Media::setStageBgm(int levelIndex)
-{
-    if (!m_bgm) {
-        return;
-    }
-
     QUrl src;
 
     // For each level, try to use a dedicated BGM if present.
@@ -198,67 +101,154 @@ void Media::setStageBgm(int levelIndex)
         src = defaultBgmUrl();
     }
 
-    if (!src.isEmpty()) {
-        m_bgm->setSource(src);
-    }
+    return src;
+}
 
-    // Ensure it actually starts playing after changing source
-    m_bgm->play();
+} // namespace
+
+Media::Media(QObject* parent)
+    : QObject(parent)
+{
+    TRACE_SCOPE("Media::Media");
+    // --- SFX: driving loop, nitro, pickups and game over ---
+    m_mixer = new AudioMixer(this);
+    m_accelSound = m_mixer->load(QUrl(QStringLiteral("qrc:/sfx/accelerate.wav")));
+    m_nitroSound = m_mixer->load(QUrl(QStringLiteral("qrc:/sfx/nitro.wav")));
+    m_coinSound  = m_mixer->load(QUrl(QStringLiteral("qrc:/sfx/coin.mp3")));
+    m_fuelSound  = m_mixer->load(QUrl(QStringLiteral("qrc:/sfx/fuel.mp3")));
+    m_gameOverSound = m_mixer->load(QUrl(QStringLiteral("qrc:/sfx/gameOver.mp3")));
+    connect(m_mixer, &AudioMixer::ready, this, &Media::checkReady);
 }
 
+Media::~Media() = default;
+
 // -----------------------------------------------------------------------------
-// Accelerate / driving loop
+// Background music setup / control
 // -----------------------------------------------------------------------------
-void Media::startAccelLoop()
+void Media::setupBgm()
 {
-    if (m_driveSfx.isEmpty()) {
-        return;
+    TRACE_SCOPE("Media::setupBgm");
+    m_bgmEnabled = true;
+
+    // Default source at startup (intro / menu)
+    const QUrl src = defaultBgmUrl();
+    if (!src.isEmpty()) {
+        m_bgmSound = bgmSoundFor(src);
     }
-    auto* e = m_driveSfx[0];
+}
 
-    // Stop any existing fade-out
-    if (m_accelFade) {
-        m_accelFade->stop();
-        delete m_accelFade;
-        m_accelFade = nullptr;
+int Media::bgmSoundFor(const QUrl& src)
+{
+    const QString key = src.toString();
+    auto it = m_bgmSounds.constFind(key);
+    if (it != m_bgmSounds.constEnd()) {
+        return it.value();
     }
+    const int id = m_mixer->load(src);
+    m_bgmSounds.insert(key, id);
+    return id;
+}
 
-    e->setLoopCount(QSoundEffect::Infinite);
-    e->setVolume(1.0);
-    if (!e->isPlaying()) {
-        e->play();
+bool Media::isReady() const
+{
+    return m_mixer->isReady();
+}
+
+void Media::checkReady()
+{
+    if (!m_readySignalled && isReady()) {
+        m_readySignalled = true;
+        emit ready();
     }
 }
 
-void Media::stopAccelLoop()
+void Media::setBgmVolume(qreal v)
 {
-    if (m_driveSfx.isEmpty()) {
-        return;
+    TRACE_SCOPE("Media::setBgmVolume");
+    m_bgmGain = float(v);
+    m_mixer->setGain(BgmTag, m_bgmGain);
+}
+
+void Media::playBgm()
+{
+    TRACE_SCOPE("Media::playBgm");
+    // Loops; starting the track that is already playing keeps it going
+    if (m_bgmSound >= 0) {
+        m_mixer->play(m_bgmSound, m_bgmGain, BgmTag, AudioMixer::Mode::Loop);
     }
-    auto* e = m_driveSfx[0];
+}
+
+void Media::stopBgm()
+{
+    TRACE_SCOPE("Media::stopBgm");
+    // A few ms of fade avoids a click
+    m_mixer->fadeOut(BgmTag, 30);
+}
 
-    if (m_accelFade) {
-        m_accelFade->stop();
-        delete m_accelFade;
-        m_accelFade = nullptr;
+// -----------------------------------------------------------------------------
+// Per-stage BGM (including NIGHTLIFE)
+// -----------------------------------------------------------------------------
+void Media::prefetchStageBgm(int levelIndex)
+{
+    TRACE_SCOPE("Media::prefetchStageBgm");
+    // Starts loading (cache mapping or decode) in the background
+    if (m_bgmEnabled) {
+        const QUrl src = stageBgmUrl(levelIndex);
+        if (!src.isEmpty()) {
+            m_nextBgmSound = bgmSoundFor(src);
+            evictBgm();
+        }
     }
+}
 
-    // Fade volume to zero, then stop
-    m_accelFade = new QPropertyAnimation(e, "volume", this);
-    m_accelFade->setStartValue(e->volume());
-    m_accelFade->setEndValue(0.0);
-    m_accelFade->setDuration(250);
-
-    connect(m_accelFade, &QPropertyAnimation::finished, this, [this, e] {
-        e->stop();
-        e->setVolume(0.0);
-        if (m_accelFade) {
-            m_accelFade->deleteLater();
-            m_accelFade = nullptr;
+void Media::evictBgm()
+{
+    // Tracks the player scrolled past; one still fading out is freed when it ends
+    for (auto it = m_bgmSounds.begin(); it != m_bgmSounds.end();) {
+        if (it.value() != m_bgmSound && it.value() != m_nextBgmSound) {
+            m_mixer->unload(it.value());
+            it = m_bgmSounds.erase(it);
+        } else {
+            ++it;
         }
-    });
+    }
+}
+
+void Media::setStageBgm(int levelIndex)
+{
+    TRACE_SCOPE("Media::setStageBgm");
+    if (!m_bgmEnabled) {
+        return;
+    }
+
+    const QUrl src = stageBgmUrl(levelIndex);
+    if (!src.isEmpty()) {
+        m_bgmSound = bgmSoundFor(src);
+    }
 
-    m_accelFade->start();
+    // Fades over from the current track; only queues a mixer command, so it
+    // never waits on the track. A prefetched track is heard right away.
+    if (m_bgmSound >= 0) {
+        m_mixer->crossfadeTo(m_bgmSound, m_bgmGain, BgmTag, BGM_CROSSFADE_MS);
+    }
+    evictBgm();
+}
+
+// -----------------------------------------------------------------------------
+// Accelerate / driving loop
+// -----------------------------------------------------------------------------
+void Media::startAccelLoop()
+{
+    TRACE_SCOPE("Media::startAccelLoop");
+    // Keeps an already running loop going and cancels any fade-out
+    m_mixer->play(m_accelSound, 1.0f, AccelTag, AudioMixer::Mode::Loop);
+}
+
+void Media::stopAccelLoop()
+{
+    TRACE_SCOPE("Media::stopAccelLoop");
+    // Fade volume to zero, then stop
+    m_mixer->fadeOut(AccelTag, 250);
 }
 
 // -----------------------------------------------------------------------------
@@ -266,13 +256,8 @@ void Media::stopAccelLoop()
 // -----------------------------------------------------------------------------
 void Media::playNitroOnce()
 {
-    if (!m_nitroSfx) {
-        return;
-    }
-    m_nitroSfx->stop();
-    m_nitroSfx->setLoopCount(1);
-    m_nitroSfx->setVolume(0.35);
-    m_nitroSfx->play();
+    TRACE_SCOPE("Media::playNitroOnce");
+    m_mixer->play(m_nitroSound, SFX_GAIN, NitroTag, AudioMixer::Mode::Restart);
 }
 
 // -----------------------------------------------------------------------------
@@ -280,24 +265,14 @@ void Media::playNitroOnce()
 // -----------------------------------------------------------------------------
 void Media::coinPickup()
 {
-    if (m_coinPlayers.isEmpty()) {
-        return;
-    }
-    m_nextCoinPl = (m_nextCoinPl + 1) % m_coinPlayers.size();
-    auto* p = m_coinPlayers[m_nextCoinPl];
-    p->setPosition(0);
-    p->play();
+    TRACE_SCOPE("Media::coinPickup");
+    m_mixer->play(m_coinSound, SFX_GAIN);
 }
 
 void Media::fuelPickup()
 {
-    if (m_fuelPlayers.isEmpty()) {
-        return;
-    }
-    m_nextFuelPl = (m_nextFuelPl + 1) % m_fuelPlayers.size();
-    auto* p = m_fuelPlayers[m_nextFuelPl];
-    p->setPosition(0);
-    p->play();
+    TRACE_SCOPE("Media::fuelPickup");
+    m_mixer->play(m_fuelSound, SFX_GAIN);
 }
 
 // -----------------------------------------------------------------------------
@@ -305,9 +280,6 @@ void Media::fuelPickup()
 // -----------------------------------------------------------------------------
 void Media::playGameOverOnce()
 {
-    if (!m_gameOver) {
-        return;
-    }
-    m_gameOver->setPosition(0);
-    m_gameOver->play();
+    TRACE_SCOPE("Media::playGameOverOnce");
+    m_mixer->play(m_gameOverSound, SFX_GAIN, GameOverTag, AudioMixer::Mode::Restart);
 }
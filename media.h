@@ -1,12 +1,11 @@
 #pragma once
 
 #include <QObject>
-#include <QVector>
+#include <QHash>
+#include <QString>
 
-class QAudioOutput;
-class QMediaPlayer;
-class QSoundEffect;
-class QPropertyAnimation;
+class QUrl;
+class AudioMixer;
 
 class Media : public QObject {
     Q_OBJECT
@@ -22,6 +21,8 @@ public:
 
     // Per-stage BGM (now also supports NIGHTLIFE)
     void setStageBgm(int levelIndex);
+    // Loads a stage's track ahead of setStageBgm() so the switch is immediate
+    void prefetchStageBgm(int levelIndex);
 
     // Engine / driving SFX
     void startAccelLoop();
@@ -37,29 +38,34 @@ public:
     // Game over SFX
     void playGameOverOnce();
 
-private:
-    // BGM
-    QAudioOutput* m_bgmOut = nullptr;
-    QMediaPlayer* m_bgm    = nullptr;
+    // True once the SFX and the current BGM track have loaded (or failed)
+    bool isReady() const;
 
-    // Driving loop SFX
-    QVector<QSoundEffect*> m_driveSfx;
-    QPropertyAnimation*    m_accelFade = nullptr;
+signals:
+    void ready();
 
-    // Nitro SFX
-    QSoundEffect* m_nitroSfx = nullptr;
+private:
+    void checkReady();
+    int  bgmSoundFor(const QUrl& src);
+    void evictBgm();
 
-    // Coin SFX pool
-    QVector<QMediaPlayer*> m_coinPlayers;
-    QVector<QAudioOutput*> m_coinOuts;
-    int m_nextCoinPl = -1;
+    // All audio (BGM and SFX) is decoded once, cached on disk and mixed here
+    AudioMixer* m_mixer = nullptr;
 
-    // Fuel SFX pool
-    QVector<QMediaPlayer*> m_fuelPlayers;
-    QVector<QAudioOutput*> m_fuelOuts;
-    int m_nextFuelPl = -1;
+    // BGM: one mixer sound per track, loaded on first use. Only the current
+    // track and the last prefetched one are kept; a full track is tens of MB.
+    QHash<QString, int> m_bgmSounds;
+    bool  m_bgmEnabled = false;   // set by setupBgm()
+    int   m_bgmSound = -1;
+    int   m_nextBgmSound = -1;    // last prefetched
+    float m_bgmGain  = 1.0f;
 
-    // Game over SFX
-    QAudioOutput* m_gameOverOut = nullptr;
-    QMediaPlayer* m_gameOver    = nullptr;
+    // SFX
+    int m_accelSound    = -1;
+    int m_nitroSound    = -1;
+    int m_coinSound     = -1;
+    int m_fuelSound     = -1;
+    int m_gameOverSound = -1;
+
+    bool m_readySignalled = false;
 };
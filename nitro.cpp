@@ -1,4 +1,5 @@
 #include "nitro.h"
+#include "hudtext.h"
 
 void NitroSystem::update(
     bool nitroKey,
@@ -75,18 +76,19 @@ void NitroSystem::drawHUD(QPainter& p, double elapsedSeconds, int levelIndex) co
     plot(1,3,hull); plot(2,3,hull); plot(3,3,hull); plot(4,3,hull);
     plot(0,2,flame1); plot(0,3,flame2);
     plot(2,4,shadow);
-    QFont f; f.setFamily("Monospace"); f.setBold(true); f.setPointSize(12);
-    p.setFont(f);
-
     // UPDATED: Access textColor via LEVELS
     p.setPen(Constants::LEVELS[levelIndex].textColor);
 
+    int pxText = (baseGX + 8) * Constants::PIXEL_SIZE;
+    int pyText = (baseGY + 5) * Constants::PIXEL_SIZE;
+    HudText::draw(p, pxText, pyText, QString::number(hudCountdown(elapsedSeconds)));
+}
+
+int NitroSystem::hudCountdown(double elapsedSeconds) const {
     double tleft = 0.0;
     if (active) tleft = std::max(0.0, endTime - elapsedSeconds);
     else if (elapsedSeconds < cooldownUntil) tleft = std::max(0.0, cooldownUntil - elapsedSeconds);
-    int pxText = (baseGX + 8) * Constants::PIXEL_SIZE;
-    int pyText = (baseGY + 5) * Constants::PIXEL_SIZE;
-    p.drawText(pxText, pyText, QString::number(int(std::ceil(tleft))));
+    return int(std::ceil(tleft));
 }
 
 
@@ -32,6 +32,8 @@ public:
 
     // Keep the *previous* pixel HUD (rocket icon + countdown)
     void drawHUD(QPainter& p, double elapsedSeconds, int levelIndex) const;
+    // Whole seconds shown next to the rocket icon (burn left, then cooldown left)
+    int hudCountdown(double elapsedSeconds) const;
 
     // Keep the *previous* nitro flame look (based on first/back wheel and first front)
     void drawFlame(QPainter& p, const QList<Wheel*>& wheels, int cameraX, int cameraY, int viewW, int viewH) const;
@@ -2,13 +2,12 @@
 #include "outro.h"
 #include "intro.h"
 #include "constants.h"
+#include "pixelfont.h"
 #include <QPainter>
 #include <QPaintEvent>
 #include <QPushButton>
 #include <QMouseEvent>
-#include <QMap>
 #include <array>
-#include <initializer_list>
 #include <algorithm>
 
 namespace {
@@ -17,56 +16,52 @@ namespace {
 
     inline int textHeightCells(int scale){ return 7*scale; }
 
-    inline void plotGridPixel(QPainter& p, int cell, int gx, int gy, const QColor& c) {
-        p.fillRect(gx*cell, gy*cell, cell, cell, c);
-    }
-
     // ----- Minimal 5x7 bitmap font (uppercase, digits, :, . and space) -----
-    static std::array<uint8_t,7> glyph(std::initializer_list<uint8_t> rows){
-        std::array<uint8_t,7> a{0,0,0,0,0,0,0};
-        int i=0; for(uint8_t r: rows){ if(i<7) a[i++]=r; }
-        return a;
-    }
-    static QMap<QChar, std::array<uint8_t,7>> make_font_map(){
-        QMap<QChar, std::array<uint8_t,7>> m;
+    constexpr GlyphTable make_font_map(){
+        GlyphTable m;
         // basics
-        m.insert(' ', glyph({0x00,0x00,0x00,0x00,0x00,0x00,0x00}));
-        m.insert(':', glyph({0x00,0x04,0x00,0x00,0x04,0x00,0x00}));
-        m.insert('.', glyph({0x00,0x00,0x00,0x00,0x00,0x00,0x04}));
+        m.set(' ', {0x00,0x00,0x00,0x00,0x00,0x00,0x00});
+        m.set(':', {0x00,0x04,0x00,0x00,0x04,0x00,0x00});
+        m.set('.', {0x00,0x00,0x00,0x00,0x00,0x00,0x04});
         // digits
-        m.insert('0', glyph({0x0E,0x11,0x19,0x15,0x13,0x11,0x0E}));
-        m.insert('1', glyph({0x04,0x0C,0x04,0x04,0x04,0x04,0x1F}));
-        m.insert('2', glyph({0x1E,0x01,0x01,0x0E,0x10,0x10,0x1F}));
-        m.insert('3', glyph({0x1E,0x01,0x01,0x0E,0x01,0x01,0x1E}));
-        m.insert('4', glyph({0x02,0x06,0x0A,0x12,0x1F,0x02,0x02}));
-        m.insert('5', glyph({0x1F,0x10,0x10,0x1E,0x01,0x01,0x1E}));
-        m.insert('6', glyph({0x0E,0x10,0x10,0x1E,0x11,0x11,0x0E}));
-        m.insert('7', glyph({0x1F,0x01,0x02,0x04,0x08,0x08,0x08}));
-        m.insert('8', glyph({0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E}));
-        m.insert('9', glyph({0x0E,0x11,0x11,0x0F,0x01,0x01,0x0E}));
+        m.set('0', {0x0E,0x11,0x19,0x15,0x13,0x11,0x0E});
+        m.set('1', {0x04,0x0C,0x04,0x04,0x04,0x04,0x1F});
+        m.set('2', {0x1E,0x01,0x01,0x0E,0x10,0x10,0x1F});
+        m.set('3', {0x1E,0x01,0x01,0x0E,0x01,0x01,0x1E});
+        m.set('4', {0x02,0x06,0x0A,0x12,0x1F,0x02,0x02});
+        m.set('5', {0x1F,0x10,0x10,0x1E,0x01,0x01,0x1E});
+        m.set('6', {0x0E,0x10,0x10,0x1E,0x11,0x11,0x0E});
+        m.set('7', {0x1F,0x01,0x02,0x04,0x08,0x08,0x08});
+        m.set('8', {0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E});
+        m.set('9', {0x0E,0x11,0x11,0x0F,0x01,0x01,0x0E});
         // letters used in the panel texts
-        m.insert('A', glyph({0x0E,0x11,0x11,0x1F,0x11,0x11,0x11}));
-        m.insert('C', glyph({0x0E,0x11,0x10,0x10,0x10,0x11,0x0E}));
-        m.insert('D', glyph({0x1E,0x11,0x11,0x11,0x11,0x11,0x1E}));
-        m.insert('E', glyph({0x1F,0x10,0x1E,0x10,0x10,0x10,0x1F}));
-        m.insert('F', glyph({0x1F,0x10,0x1E,0x10,0x10,0x10,0x10}));
-        m.insert('G', glyph({0x0E,0x11,0x10,0x17,0x11,0x11,0x0E}));
-        m.insert('I', glyph({0x0E,0x04,0x04,0x04,0x04,0x04,0x0E}));
-        m.insert('L', glyph({0x10,0x10,0x10,0x10,0x10,0x10,0x1F}));
-        m.insert('M', glyph({0x11,0x1B,0x15,0x11,0x11,0x11,0x11}));
-        m.insert('O', glyph({0x0E,0x11,0x11,0x11,0x11,0x11,0x0E}));
-        m.insert('P', glyph({0x1E,0x11,0x11,0x1E,0x10,0x10,0x10}));
-        m.insert('R', glyph({0x1E,0x11,0x11,0x1E,0x12,0x11,0x11}));
-        m.insert('S', glyph({0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E}));
-        m.insert('T', glyph({0x1F,0x04,0x04,0x04,0x04,0x04,0x04}));
-        m.insert('V', glyph({0x11,0x11,0x11,0x11,0x11,0x0A,0x04}));
-        m.insert('X', glyph({0x11,0x11,0x0A,0x04,0x0A,0x11,0x11}));
+        m.set('A', {0x0E,0x11,0x11,0x1F,0x11,0x11,0x11});
+        m.set('C', {0x0E,0x11,0x10,0x10,0x10,0x11,0x0E});
+        m.set('D', {0x1E,0x11,0x11,0x11,0x11,0x11,0x1E});
+        m.set('E', {0x1F,0x10,0x1E,0x10,0x10,0x10,0x1F});
+        m.set('F', {0x1F,0x10,0x1E,0x10,0x10,0x10,0x10});
+        m.set('G', {0x0E,0x11,0x10,0x17,0x11,0x11,0x0E});
+        m.set('I', {0x0E,0x04,0x04,0x04,0x04,0x04,0x0E});
+        m.set('L', {0x10,0x10,0x10,0x10,0x10,0x10,0x1F});
+        m.set('M', {0x11,0x1B,0x15,0x11,0x11,0x11,0x11});
+        m.set('O', {0x0E,0x11,0x11,0x11,0x11,0x11,0x0E});
+        m.set('P', {0x1E,0x11,0x11,0x1E,0x10,0x10,0x10});
+        m.set('R', {0x1E,0x11,0x11,0x1E,0x12,0x11,0x11});
+        m.set('S', {0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E});
+        m.set('T', {0x1F,0x04,0x04,0x04,0x04,0x04,0x04});
+        m.set('V', {0x11,0x11,0x11,0x11,0x11,0x0A,0x04});
+        m.set('X', {0x11,0x11,0x0A,0x04,0x0A,0x11,0x11});
         return m;
     }
-    static const QMap<QChar, std::array<uint8_t,7>> font_map = make_font_map();
+    constexpr GlyphTable font_map = make_font_map();
+
+    PixelFont& outroFont(){
+        static PixelFont f(font_map, CHAR_ADV, true);
+        return f;
+    }
 
     inline int textWidthCells(const QString& s, int scale){
-        return s.isEmpty()?0:((int)s.size()-1)*CHAR_ADV*scale + 5*scale;
+        return outroFont().widthCells(s, scale);
     }
 
     inline int fitTextScale(int wCells, int hCells, const QString& s){
@@ -76,30 +71,7 @@ namespace {
     }
 
     void drawPixelText(QPainter& p, const QString& s, int cell, int gx, int gy, int scale, const QColor& c, bool bold){
-        auto plot=[&](int x,int y,const QColor& col){ plotGridPixel(p,cell,gx+x,gy+y,col); };
-        for(int i=0;i<s.size();++i){
-            const QChar ch=s.at(i).toUpper();
-            const auto rows=font_map.value(font_map.contains(ch)?ch:QChar(' '));
-            int base=i*CHAR_ADV*scale;
-            for(int ry=0;ry<7;++ry){
-                uint8_t row=rows[ry];
-                for(int rx=0;rx<5;++rx){
-                    if(row&(1<<(4-rx))){
-                        for(int sy=0;sy<scale;++sy){
-                            for(int sx=0;sx<scale;++sx){
-                                if(bold){
-                                    plot(base+rx*scale+sx-1,ry*scale+sy,QColor(20,20,22));
-                                    plot(base+rx*scale+sx+1,ry*scale+sy,QColor(20,20,22));
-                                    plot(base+rx*scale+sx,ry*scale+sy-1,QColor(20,20,22));
-                                    plot(base+rx*scale+sx,ry*scale+sy+1,QColor(20,20,22));
-                                }
-                                plot(base+rx*scale+sx,ry*scale+sy,c);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        outroFont().draw(p, s, gx, gy, cell, scale, c, bold, QColor(20,20,22));
     }
 }
 
@@ -1,4 +1,5 @@
 #include "pause.h"
+#include "pixelfont.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <algorithm>
@@ -84,40 +85,11 @@ void PauseOverlay::resizeEvent(QResizeEvent*) {
 }
 
 int PauseOverlay::textWidthCells(const QString& s, int scale) const {
-    if (s.isEmpty()) return 0;
-    return (int(s.size()) - 1) * CHAR_ADV * scale + 5 * scale;
+    return PixelFont::standard().widthCells(s, scale);
 }
 
 void PauseOverlay::drawPixelText(QPainter& p, const QString& s, int gx, int gy, int scale, const QColor& c, bool bold) {
-    auto plot = [&](int x,int y,const QColor& col){ plotGridPixel(p, gx + x, gy + y, col); };
-    for (int i = 0; i < s.size(); ++i) {
-        const QChar ch = s.at(i).toUpper();
-        const auto rows = font_map.value(font_map.contains(ch) ? ch : QChar(' '));
-        int baseOff = i * CHAR_ADV * scale;
-        for (int ry=0; ry<7; ++ry) {
-            uint8_t row = rows[ry];
-            for (int rx=0; rx<5; ++rx) {
-                if (row & (1<<(4-rx))) {
-                    for (int sy=0; sy<scale; ++sy) {
-                        for (int sx=0; sx<scale; ++sx) {
-                            if (bold) {
-                                plot(baseOff + rx*scale+sx-1, ry*scale+sy, c);
-                                plot(baseOff + rx*scale+sx+1, ry*scale+sy, c);
-                                plot(baseOff + rx*scale+sx, ry*scale+sy-1, c);
-                                plot(baseOff + rx*scale+sx, ry*scale+sy+1, c);
-                            }
-                            plot(baseOff + rx*scale+sx, ry*scale+sy, c);
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-void PauseOverlay::plotGridPixel(QPainter& p, int gx, int gy, const QColor& c) {
-    if (gx < 0 || gy < 0 || gx >= gridW()+1 || gy >= gridH()+1) return;
-    p.fillRect(gx * Constants::PIXEL_SIZE, gy * Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, c);
+    PixelFont::standard().draw(p, s, gx, gy, Constants::PIXEL_SIZE, scale, c, bold);
 }
 
 QRect PauseOverlay::resumeRectPx() const {
@@ -28,6 +28,5 @@ private:
     inline int gridH() const { return height() / Constants::PIXEL_SIZE; }
     int textWidthCells(const QString& s, int scale) const;
     void drawPixelText(QPainter& p, const QString& s, int gx, int gy, int scale, const QColor& c, bool bold);
-    void plotGridPixel(QPainter& p, int gx, int gy, const QColor& c);
     QRect resumeRectPx() const;
 };
@@ -0,0 +1,109 @@
+// pcmcache.cpp
+#include "pcmcache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <cstring>
+
+namespace {
+
+// File layout: Header, then `count` native-endian qint16 samples.
+struct Header {
+    char    magic[4];
+    quint32 version;
+    quint32 reserved;
+    quint32 headerSize;
+};
+static_assert(sizeof(Header) == 16, "keeps the samples 16-byte aligned in the mapping");
+
+constexpr char    MAGIC[4] = {'B', 'B', 'P', 'C'};
+constexpr quint32 VERSION  = 1;
+
+QString cacheDir() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/pcm");
+}
+
+QString localPath(const QUrl& src) {
+    if (src.scheme() == QLatin1String("qrc")) return QLatin1Char(':') + src.path();
+    return src.toLocalFile();
+}
+
+// "coin.mp3-<hash>-44100x2" -> "coin.mp3-"
+QString assetPrefix(const QString& key) {
+    return key.left(key.indexOf(QLatin1Char('-')) + 1);
+}
+
+} // namespace
+
+QString PcmCache::keyFor(const QUrl& src, const QAudioFormat& format) {
+    QFile f(localPath(src));
+    if (!f.open(QIODevice::ReadOnly)) return {};
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&f)) return {};
+
+    const QString name = QFileInfo(f.fileName()).fileName().replace(QLatin1Char('-'), QLatin1Char('_'));
+    return QStringLiteral("%1-%2-%3x%4")
+        .arg(name, QString::fromLatin1(hash.result().toHex().left(16)))
+        .arg(format.sampleRate())
+        .arg(format.channelCount());
+}
+
+PcmCache::Mapped PcmCache::open(const QString& key) {
+    Mapped m;
+    if (key.isEmpty()) return m;
+
+    auto file = std::make_shared<QFile>(cacheDir() + QLatin1Char('/') + key + QStringLiteral(".pcm"));
+    if (!file->open(QIODevice::ReadOnly)) return m;
+
+    const qint64 size = file->size();
+    if (size <= qint64(sizeof(Header)) || (size - qint64(sizeof(Header))) % qint64(sizeof(qint16)) != 0)
+        return m;
+
+    uchar* base = file->map(0, size);
+    if (!base) return m;
+
+    Header h;
+    std::memcpy(&h, base, sizeof(Header));
+    if (std::memcmp(h.magic, MAGIC, 4) != 0 || h.version != VERSION || h.headerSize != sizeof(Header))
+        return m;
+
+    m.file    = std::move(file);
+    m.samples = reinterpret_cast<const qint16*>(base + sizeof(Header));
+    m.count   = (size - qint64(sizeof(Header))) / qint64(sizeof(qint16));
+    return m;
+}
+
+bool PcmCache::store(const QString& key, const QVector<QVector<qint16>>& parts) {
+    if (key.isEmpty() || parts.isEmpty()) return false;
+
+    const QString dir = cacheDir();
+    if (!QDir().mkpath(dir)) return false;
+
+    QSaveFile out(dir + QLatin1Char('/') + key + QStringLiteral(".pcm"));
+    if (!out.open(QIODevice::WriteOnly)) return false;
+
+    Header h{};
+    std::memcpy(h.magic, MAGIC, 4);
+    h.version    = VERSION;
+    h.headerSize = sizeof(Header);
+    if (out.write(reinterpret_cast<const char*>(&h), sizeof(Header)) != qint64(sizeof(Header)))
+        return false;
+    for (const QVector<qint16>& pcm : parts) {
+        const qint64 bytes = qint64(pcm.size()) * qint64(sizeof(qint16));
+        if (out.write(reinterpret_cast<const char*>(pcm.constData()), bytes) != bytes) return false;
+    }
+    if (!out.commit()) return false;
+
+    // Older decodes of the same asset (changed resource or output format) are stale now.
+    const QString keep = key + QStringLiteral(".pcm");
+    QDir d(dir);
+    const QStringList stale = d.entryList({assetPrefix(key) + QStringLiteral("*.pcm")}, QDir::Files);
+    for (const QString& name : stale) {
+        if (name != keep) d.remove(name);
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+// pcmcache.h
+#ifndef PCMCACHE_H
+#define PCMCACHE_H
+
+#include <QAudioFormat>
+#include <QString>
+#include <QUrl>
+#include <QVector>
+#include <QtGlobal>
+#include <memory>
+
+class QFile;
+
+// Decoded 16-bit PCM kept on disk between launches, one file per asset and
+// output format under the app's cache directory. Files are named after the
+// asset and a hash of its compressed bytes, so an asset that changes gets a new
+// key and its old file is deleted when the new one is stored. Stored files are
+// read back through a read-only memory mapping instead of being decoded again.
+// All functions are thread-safe; they only touch the file system.
+namespace PcmCache {
+    // A mapped cache file; the samples stay valid while any copy is alive.
+    struct Mapped {
+        std::shared_ptr<QFile> file;
+        const qint16* samples = nullptr;
+        qint64 count = 0;
+        bool isValid() const { return samples && count > 0; }
+    };
+
+    // Empty if src cannot be read (e.g. a missing file).
+    QString keyFor(const QUrl& src, const QAudioFormat& format);
+    Mapped open(const QString& key);
+    // Writes the parts back to back as one sound.
+    bool store(const QString& key, const QVector<QVector<qint16>>& parts);
+}
+
+#endif // PCMCACHE_H
@@ -0,0 +1,159 @@
+// perfprobe.cpp
+#include "perfprobe.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QtMath>
+#include <QPainter>
+#include <QString>
+#include "hudtext.h"
+#include "trace.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace {
+
+#if defined(BB_PERF_PROBES)
+
+constexpr std::array<const char*, Perf::PhaseCount> PHASE_NAMES = {{
+    "terrain gen", "physics", "pickups", "terrain fill", "props", "sky", "car", "hud"
+}};
+
+QElapsedTimer& probeClock() {
+    static QElapsedTimer c = [] { QElapsedTimer t; t.start(); return t; }();
+    return c;
+}
+
+struct Sample {
+    float totalMs = 0;
+    std::array<float, Perf::PhaseCount> phaseMs{};
+};
+
+std::array<std::atomic<qint64>, Perf::PhaseCount> s_open{};   // ns, frame in progress
+std::array<Sample, Perf::Overlay::HISTORY> s_history;
+int    s_frames = 0;                                          // frames recorded so far
+qint64 s_frameStart = -1;
+
+#endif
+
+} // namespace
+
+#if defined(BB_PERF_PROBES)
+
+qint64 Perf::nowNs() {
+    return probeClock().nsecsElapsed();
+}
+
+void Perf::add(Phase phase, qint64 startNs, qint64 endNs) {
+    s_open[phase].fetch_add(endNs - startNs, std::memory_order_relaxed);
+    if (Trace::active()) Trace::complete(PHASE_NAMES[phase], startNs, endNs - startNs);
+}
+
+void Perf::endFrame() {
+    const qint64 now = nowNs();
+    if (s_frameStart < 0) {
+        for (auto& open : s_open) open.store(0, std::memory_order_relaxed);
+        s_frameStart = now;
+        return;
+    }
+    Sample& s = s_history[s_frames % Overlay::HISTORY];
+    s.totalMs = float((now - s_frameStart) / 1e6);
+    for (int i = 0; i < PhaseCount; ++i) s.phaseMs[i] = float(s_open[i].exchange(0, std::memory_order_relaxed) / 1e6);
+    if (Trace::active()) {
+        Trace::complete("frame", s_frameStart, now - s_frameStart);
+        Trace::frameFinished(now - s_frameStart);
+    }
+    s_frameStart = now;
+    ++s_frames;
+}
+
+void Perf::resetFrameClock() {
+    s_frameStart = -1;
+}
+
+#endif
+
+void Perf::Overlay::draw(QPainter& p, int x, int y) {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const qreal dpr = p.device()->devicePixelRatioF();
+    if (m_builtAtMs < 0 || nowMs - m_builtAtMs >= REFRESH_MS || m_image.devicePixelRatio() != dpr) {
+        rebuild(dpr);
+        m_builtAtMs = nowMs;
+    }
+    p.drawImage(x, y, m_image);
+}
+
+void Perf::Overlay::rebuild(qreal dpr) {
+    constexpr int W = WIDTH, PAD = 8, LINE = 14;
+
+#if defined(BB_PERF_PROBES)
+    const int n = std::min(s_frames, HISTORY);
+    const int H = PAD * 2 + LINE * (3 + PhaseCount) + 50;
+#else
+    const int H = PAD * 2 + LINE * 2;
+#endif
+
+    const QSize px(qCeil(W * dpr), qCeil(H * dpr));
+    if (m_image.size() != px) m_image = QImage(px, QImage::Format_ARGB32_Premultiplied);
+    m_image.setDevicePixelRatio(dpr);
+    m_image.fill(QColor(0, 0, 0, 170));
+
+    QPainter ip(&m_image);
+    ip.setFont(HudText::font());
+    ip.setPen(QColor(230, 230, 240));
+    int ty = PAD + LINE - 3;
+
+#if !defined(BB_PERF_PROBES)
+    ip.drawText(PAD, ty, QStringLiteral("perf probes are compiled out"));
+    ip.drawText(PAD, ty + LINE, QStringLiteral("rebuild with CONFIG+=perf_probes"));
+#else
+    if (n <= 0) return;
+
+    constexpr int BAR_X = 100, BAR_W = W - BAR_X - 60;
+    constexpr int BUCKETS = 34;             // 1 ms each; the last one collects everything slower
+    std::array<float, HISTORY> totals;
+    std::array<float, PhaseCount> mean{};
+    std::array<int, BUCKETS> hist{};
+    for (int i = 0; i < n; ++i) {
+        const Sample& s = s_history[i];
+        totals[i] = s.totalMs;
+        for (int k = 0; k < PhaseCount; ++k) mean[k] += s.phaseMs[k] / n;
+        ++hist[std::min(int(s.totalMs), BUCKETS - 1)];
+    }
+    auto pct = [&](int q) {
+        const int k = std::min(n - 1, n * q / 100);
+        std::nth_element(totals.begin(), totals.begin() + k, totals.begin() + n);
+        return totals[k];
+    };
+    const float p50 = pct(50), p95 = pct(95), p99 = pct(99);
+
+    ip.drawText(PAD, ty, QStringLiteral("frame  p50 %1  p95 %2  p99 %3 ms")
+                             .arg(p50, 0, 'f', 1).arg(p95, 0, 'f', 1).arg(p99, 0, 'f', 1));
+    ty += LINE;
+    ip.setPen(QColor(170, 170, 190));
+    ip.drawText(PAD, ty, QStringLiteral("mean per frame over %1 frames").arg(n));
+    ty += LINE;
+
+    // One bar per phase, full width = one 60 Hz frame.
+    const float scale = BAR_W / 16.7f;
+    for (int k = 0; k < PhaseCount; ++k) {
+        ip.setPen(QColor(220, 220, 230));
+        ip.drawText(PAD, ty, QString::fromLatin1(PHASE_NAMES[k]));
+        const int w = std::clamp(int(mean[k] * scale), mean[k] > 0 ? 1 : 0, BAR_W);
+        ip.fillRect(BAR_X, ty - LINE + 5, w, LINE - 4, mean[k] > 4.0f ? QColor(230, 90, 70) : QColor(90, 190, 120));
+        ip.drawText(BAR_X + BAR_W + 6, ty, QString::number(mean[k], 'f', 2));
+        ty += LINE;
+    }
+
+    // Frame-time histogram, 0..33+ ms, with 16.7 and 33.3 ms marks.
+    const int histTop = ty + 2, histH = 40, colW = (W - 2 * PAD) / BUCKETS;
+    const int peak = *std::max_element(hist.begin(), hist.end());
+    for (int b = 0; b < BUCKETS; ++b) {
+        const int h = peak ? std::max(hist[b] ? 1 : 0, hist[b] * histH / peak) : 0;
+        ip.fillRect(PAD + b * colW, histTop + histH - h, colW - 1, h,
+                    b >= 33 ? QColor(230, 90, 70) : b >= 16 ? QColor(230, 190, 70) : QColor(90, 190, 120));
+    }
+    ip.fillRect(PAD + 16 * colW + colW * 7 / 10, histTop, 1, histH, QColor(255, 255, 255, 90));
+    ip.fillRect(PAD + 33 * colW + colW * 3 / 10, histTop, 1, histH, QColor(255, 255, 255, 90));
+#endif
+}
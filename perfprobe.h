@@ -0,0 +1,89 @@
+// perfprobe.h
+#ifndef PERFPROBE_H
+#define PERFPROBE_H
+
+#include <QImage>
+#include <QtGlobal>
+
+class QPainter;
+
+// Scoped timers around the expensive phases of a frame, and the overlay that
+// shows them (F3). Probes exist only when BB_PERF_PROBES is defined, which the
+// .pro does for debug builds and for `qmake CONFIG+=perf_probes`; otherwise
+// PERF_SCOPE expands to nothing and endFrame() is empty.
+//
+// A phase accumulates every scope that closed since the last endFrame(), so
+// simulation phases cover all game ticks behind one painted frame and band
+// phases add up the time spent on every render thread. Scopes may close on any
+// thread; endFrame() and the overlay are GUI thread only.
+namespace Perf {
+
+enum Phase {
+    Terrain,        // ensureAheadTerrain
+    Physics,        // wheel and body simulation
+    Pickups,
+    FilledTerrain,  // drawFilledTerrain, all bands
+    Props,          // painted once after the bands join
+    Sky,            // stars and clouds, all bands
+    Car,
+    Hud,
+    PhaseCount
+};
+
+#if defined(BB_PERF_PROBES)
+
+qint64 nowNs();
+// Also records a trace event while Trace is active (see trace.h).
+void add(Phase phase, qint64 startNs, qint64 endNs);
+// Closes the frame: its total is the time since the previous endFrame().
+// The first frame after resetFrameClock() only restarts the clock.
+void endFrame();
+// Call whenever the game stops painting frames (menus, pause), so the gap is
+// not counted as a frame.
+void resetFrameClock();
+
+class Scope {
+public:
+    explicit Scope(Phase phase) : m_phase(phase), m_start(nowNs()) {}
+    ~Scope() { add(m_phase, m_start, nowNs()); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+private:
+    Phase  m_phase;
+    qint64 m_start;
+};
+
+#define PERF_CAT2(a, b) a##b
+#define PERF_CAT(a, b) PERF_CAT2(a, b)
+#define PERF_SCOPE(phase) const Perf::Scope PERF_CAT(perfScope_, __LINE__)(Perf::phase)
+
+#else
+
+inline void endFrame() {}
+inline void resetFrameClock() {}
+#define PERF_SCOPE(phase) ((void)0)
+
+#endif
+
+// Frame-time percentiles, a frame-time histogram and one bar per phase over
+// the last HISTORY frames. The panel is rebuilt into an image at most every
+// REFRESH_MS and blitted otherwise, so showing it barely moves the numbers.
+class Overlay {
+public:
+    static constexpr int HISTORY    = 240;
+    static constexpr int WIDTH      = 300;
+    static constexpr int REFRESH_MS = 250;
+
+    // Top-left corner at (x, y) in device-independent pixels.
+    void draw(QPainter& p, int x, int y);
+
+private:
+    void rebuild(qreal dpr);
+
+    QImage m_image;
+    qint64 m_builtAtMs = -1;
+};
+
+} // namespace Perf
+
+#endif // PERFPROBE_H
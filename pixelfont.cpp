@@ -0,0 +1,101 @@
+// pixelfont.cpp
+#include "pixelfont.h"
+#include <QPainter>
+#include <algorithm>
+
+PixelFont::PixelFont(const GlyphTable& glyphs, int advance, bool upperCase)
+    : m_glyphs(glyphs), m_advance(advance), m_upperCase(upperCase) {}
+
+PixelFont& PixelFont::standard() {
+    static PixelFont f(font_map, 7, true);
+    return f;
+}
+
+int PixelFont::widthCells(const QString& s, int scale) const {
+    if (s.isEmpty()) return 0;
+    return (int(s.size()) - 1) * m_advance * scale + 5 * scale;
+}
+
+QImage PixelFont::rasterizeGlyph(const GlyphKey& key) const {
+    const int scale = key.scale;
+    QImage img(5 * scale + 2, 7 * scale + 2, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+
+    // Same plotting order as the old per-cell painters, so overlapping halo and
+    // body cells composite the same way; the image has a one-cell halo margin.
+    const QColor color = QColor::fromRgba(key.color);
+    const QColor halo  = QColor::fromRgba(key.halo);
+    const Glyph& rows = m_glyphs.glyph(QChar(key.code));
+    QPainter gp(&img);
+    for (int ry = 0; ry < 7; ++ry) {
+        const uint8_t row = rows[ry];
+        for (int rx = 0; rx < 5; ++rx) {
+            if (!(row & (1 << (4 - rx)))) continue;
+            for (int sy = 0; sy < scale; ++sy) {
+                for (int sx = 0; sx < scale; ++sx) {
+                    const int x = 1 + rx * scale + sx;
+                    const int y = 1 + ry * scale + sy;
+                    if (key.bold) {
+                        gp.fillRect(x - 1, y, 1, 1, halo);
+                        gp.fillRect(x + 1, y, 1, 1, halo);
+                        gp.fillRect(x, y - 1, 1, 1, halo);
+                        gp.fillRect(x, y + 1, 1, 1, halo);
+                    }
+                    gp.fillRect(x, y, 1, 1, color);
+                }
+            }
+        }
+    }
+    return img;
+}
+
+const QImage& PixelFont::glyph(const GlyphKey& key) {
+    auto it = m_glyphCache.find(key);
+    if (it == m_glyphCache.end()) {
+        if (m_glyphCache.size() >= MAX_GLYPHS) m_glyphCache.clear();
+        it = m_glyphCache.insert(key, rasterizeGlyph(key));
+    }
+    return it.value();
+}
+
+const QImage& PixelFont::run(const QString& s, int scale, const QColor& color, bool bold, const QColor& halo) {
+    const QRgb c = color.rgba();
+    const QRgb h = (bold && halo.isValid()) ? halo.rgba() : c;
+    RunKey key{s, scale, c, h, bold};
+
+    auto it = m_runCache.find(key);
+    if (it != m_runCache.end()) return it.value();
+
+    // Keys include the scale and colours, so one changing score can fill the
+    // cache with images nobody will ask for again. Dropping them all costs one
+    // re-render per run still in use, which is cheaper than tracking recency
+    // on every hit.
+    if (m_runCache.size() >= MAX_RUNS) m_runCache.clear();
+
+    QImage img(widthCells(s, scale) + 2, 7 * scale + 2, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+    {
+        // Glyph boxes (plus halo) never overlap at the advances in use, so the
+        // run looks the same as drawing each glyph straight to the target.
+        QPainter rp(&img);
+        for (int i = 0; i < s.size(); ++i) {
+            const QChar ch = m_upperCase ? s.at(i).toUpper() : s.at(i);
+            const Glyph& rows = m_glyphs.glyph(ch);
+            if (std::all_of(rows.begin(), rows.end(), [](uint8_t r) { return r == 0; })) continue;
+            rp.drawImage(i * m_advance * scale, 0, glyph({ch.unicode(), scale, c, h, bold}));
+        }
+    }
+    return m_runCache.insert(key, img).value();
+}
+
+void PixelFont::draw(QPainter& p, const QString& s, int gx, int gy, int cell, int scale,
+                     const QColor& color, bool bold, const QColor& halo) {
+    if (s.isEmpty() || scale <= 0 || cell <= 0) return;
+    const QImage& img = run(s, scale, color, bold, halo);
+
+    const QRect target((gx - 1) * cell, (gy - 1) * cell, img.width() * cell, img.height() * cell);
+    const bool smooth = p.testRenderHint(QPainter::SmoothPixmapTransform);
+    if (smooth) p.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    p.drawImage(target, img);
+    if (smooth) p.setRenderHint(QPainter::SmoothPixmapTransform, true);
+}
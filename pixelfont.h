@@ -0,0 +1,82 @@
+// pixelfont.h
+#ifndef PIXELFONT_H
+#define PIXELFONT_H
+
+#include <QColor>
+#include <QHash>
+#include <QImage>
+#include <QString>
+#include "constants.h"
+
+class QPainter;
+
+// Draws the 5x7 bitmap fonts on the pixel grid from cached images instead of
+// one fillRect per lit sub-cell. Each (glyph, scale, colour, bold) is rasterized
+// once at one image pixel per grid cell; strings are assembled from those glyphs
+// into text-run images that are blitted with a single nearest-neighbour
+// drawImage. Used from the GUI thread only.
+class PixelFont {
+public:
+    PixelFont(const GlyphTable& glyphs, int advance, bool upperCase);
+
+    // font_map with a 7-cell advance, uppercasing its input.
+    static PixelFont& standard();
+
+    int advance() const { return m_advance; }
+
+    // Width in grid cells; the last glyph has no trailing gap.
+    int widthCells(const QString& s, int scale) const;
+
+    // Draws s with the top-left cell of its first glyph at grid (gx, gy), where a
+    // grid cell is `cell` pixels. Bold text gets a one-cell halo around every lit
+    // cell, in `halo` if it is valid and in `color` otherwise.
+    void draw(QPainter& p, const QString& s, int gx, int gy, int cell, int scale,
+              const QColor& color, bool bold = false, const QColor& halo = QColor());
+
+    // The cached text run; its top-left pixel is grid cell (gx - 1, gy - 1).
+    const QImage& run(const QString& s, int scale, const QColor& color, bool bold, const QColor& halo);
+
+private:
+    struct GlyphKey {
+        char16_t code;
+        int      scale;
+        QRgb     color;
+        QRgb     halo;
+        bool     bold;
+        friend bool operator==(const GlyphKey& a, const GlyphKey& b) {
+            return a.code == b.code && a.scale == b.scale && a.color == b.color
+                && a.halo == b.halo && a.bold == b.bold;
+        }
+        friend size_t qHash(const GlyphKey& k, size_t seed = 0) {
+            return qHashMulti(seed, k.code, k.scale, k.color, k.halo, k.bold);
+        }
+    };
+    struct RunKey {
+        QString text;
+        int     scale;
+        QRgb    color;
+        QRgb    halo;
+        bool    bold;
+        friend bool operator==(const RunKey& a, const RunKey& b) {
+            return a.scale == b.scale && a.color == b.color && a.halo == b.halo
+                && a.bold == b.bold && a.text == b.text;
+        }
+        friend size_t qHash(const RunKey& k, size_t seed = 0) {
+            return qHashMulti(seed, k.text, k.scale, k.color, k.halo, k.bold);
+        }
+    };
+
+    static constexpr int MAX_GLYPHS = 512;
+    static constexpr int MAX_RUNS   = 64;
+
+    const QImage& glyph(const GlyphKey& key);
+    QImage rasterizeGlyph(const GlyphKey& key) const;
+
+    const GlyphTable& m_glyphs;
+    int  m_advance;
+    bool m_upperCase;
+    QHash<GlyphKey, QImage> m_glyphCache;
+    QHash<RunKey, QImage>   m_runCache;
+};
+
+#endif // PIXELFONT_H
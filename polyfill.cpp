@@ -0,0 +1,61 @@
+// polyfill.cpp
+#include "polyfill.h"
+#include <algorithm>
+#include <limits>
+
+bool PolygonFiller::buildEdgeTable(const QPoint* pts, int n, int divisor) {
+    int yMin = std::numeric_limits<int>::max();
+    int yMax = std::numeric_limits<int>::min();
+    for (int i = 0; i < n; ++i) {
+        const int y = pts[i].y() / divisor;
+        yMin = std::min(yMin, y);
+        yMax = std::max(yMax, y);
+    }
+    if (yMin >= yMax) return false;
+
+    m_yMin = yMin;
+    m_yMax = yMax;
+    m_buckets.assign(size_t(yMax - yMin + 1), -1);
+
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        const QPoint& a = pts[i];
+        const QPoint& b = pts[(i + 1) % n];
+        int x1 = a.x() / divisor, y1 = a.y() / divisor;
+        int x2 = b.x() / divisor, y2 = b.y() / divisor;
+        if (y1 == y2) continue;
+        if (y1 > y2) { std::swap(x1, x2); std::swap(y1, y2); }
+
+        Edge& e = m_edges[count];
+        e.yMax     = y2;
+        e.x        = x1;
+        e.invSlope = static_cast<double>(x2 - x1) / (y2 - y1);
+        e.next     = m_buckets[y1 - yMin];
+        m_buckets[y1 - yMin] = count;
+        ++count;
+    }
+    return count > 0;
+}
+
+void PolygonFiller::insertActive(int e) {
+    const double x = m_edges[e].x;
+    int i = m_activeCount++;
+    while (i > 0 && m_edges[m_active[i - 1]].x > x) {
+        m_active[i] = m_active[i - 1];
+        --i;
+    }
+    m_active[i] = e;
+}
+
+void PolygonFiller::sortActive() {
+    for (int i = 1; i < m_activeCount; ++i) {
+        const int e = m_active[i];
+        const double x = m_edges[e].x;
+        int j = i;
+        while (j > 0 && m_edges[m_active[j - 1]].x > x) {
+            m_active[j] = m_active[j - 1];
+            --j;
+        }
+        m_active[j] = e;
+    }
+}
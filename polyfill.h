@@ -0,0 +1,76 @@
+// polyfill.h
+#ifndef POLYFILL_H
+#define POLYFILL_H
+
+#include <QPoint>
+#include <vector>
+#include <cmath>
+
+// Scanline polygon rasterizer with reusable edge storage.
+// Edges are bucketed by their starting scanline and the active edge list is kept
+// sorted by insertion, so a fill does no allocation once the storage has grown
+// to the largest polygon seen (RESERVED_EDGES are reserved up front).
+// Filled runs are handed to a span callback as (y, xStart, xEnd) with
+// inclusive ends.
+class PolygonFiller {
+public:
+    static constexpr int RESERVED_EDGES = 64;
+
+    PolygonFiller() : m_edges(RESERVED_EDGES), m_active(RESERVED_EDGES) {}
+
+    // Every vertex is divided by `divisor` (integer division) before filling, so
+    // callers can pass world/screen points directly and fill on the cell grid.
+    template <typename SpanFn>
+    void fill(const QPoint* pts, int n, int divisor, SpanFn&& span) {
+        if (n < 3) return;
+        if (n > int(m_edges.size())) {
+            m_edges.resize(size_t(n));
+            m_active.resize(size_t(n));
+        }
+        if (!buildEdgeTable(pts, n, divisor)) return;
+
+        m_activeCount = 0;
+        for (int y = m_yMin; y < m_yMax; ++y) {
+            for (int e = m_buckets[y - m_yMin]; e >= 0; e = m_edges[e].next) insertActive(e);
+
+            int w = 0;
+            for (int i = 0; i < m_activeCount; ++i) {
+                if (m_edges[m_active[i]].yMax != y) m_active[w++] = m_active[i];
+            }
+            m_activeCount = w;
+
+            for (int i = 0; i + 1 < m_activeCount; i += 2) {
+                const int xStart = static_cast<int>(std::ceil(m_edges[m_active[i]].x));
+                const int xEnd   = static_cast<int>(std::floor(m_edges[m_active[i + 1]].x));
+                if (xStart <= xEnd) span(y, xStart, xEnd);
+            }
+
+            for (int i = 0; i < m_activeCount; ++i) {
+                Edge& edge = m_edges[m_active[i]];
+                edge.x += edge.invSlope;
+            }
+            sortActive();
+        }
+    }
+
+private:
+    struct Edge {
+        int    yMax;
+        double x;
+        double invSlope;
+        int    next;
+    };
+
+    bool buildEdgeTable(const QPoint* pts, int n, int divisor);
+    void insertActive(int e);
+    void sortActive();
+
+    std::vector<Edge> m_edges;
+    std::vector<int>  m_active;
+    int m_activeCount = 0;
+    std::vector<int> m_buckets;
+    int m_yMin = 0;
+    int m_yMax = 0;
+};
+
+#endif // POLYFILL_H
@@ -0,0 +1,179 @@
+// profilestore.cpp
+#include "profilestore.h"
+#include "trace.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QVariant>
+#include <QDebug>
+
+namespace {
+
+constexpr int VERSION = 1;
+
+QByteArray serialize(const ProfileStore::Profile& p) {
+    QJsonArray unlocks;
+    for (bool u : p.unlocks) unlocks.append(u);
+
+    QJsonArray board;
+    for (const LeaderboardEntry& e : p.leaderboard) {
+        board.append(QJsonObject{ {"stage", e.stageName}, {"user", e.userName}, {"score", e.score} });
+    }
+
+    const QJsonObject root{
+        {"version", VERSION},
+        {"grandCoins", p.grandCoins},
+        {"unlocks", unlocks},
+        {"leaderboard", board},
+        {"syncedRuns", p.syncedRuns},
+    };
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool deserialize(const QByteArray& bytes, ProfileStore::Profile& p) {
+    const QJsonDocument doc = QJsonDocument::fromJson(bytes);
+    if (!doc.isObject()) return false;
+    const QJsonObject root = doc.object();
+    if (root.value("version").toInt() != VERSION) return false;
+
+    p.grandCoins = root.value("grandCoins").toInteger();
+    p.syncedRuns = root.value("syncedRuns").toInt();
+    for (const QJsonValue& u : root.value("unlocks").toArray()) p.unlocks.append(u.toBool());
+    for (const QJsonValue& v : root.value("leaderboard").toArray()) {
+        const QJsonObject o = v.toObject();
+        LeaderboardEntry e;
+        e.stageName = o.value("stage").toString();
+        e.userName  = o.value("user").toString();
+        e.score     = o.value("score").toInt();
+        if (!e.stageName.isEmpty()) p.leaderboard.push_back(e);
+    }
+    return true;
+}
+
+} // namespace
+
+ProfileStore* ProfileStore::s_instance = nullptr;
+
+ProfileStore::ProfileStore(QObject* parent) : QObject(parent) {
+    Q_ASSERT(!s_instance);
+    s_instance = this;
+
+    m_io.setMaxThreadCount(1);
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, &QTimer::timeout, this, &ProfileStore::write);
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dir);
+    m_path = dir + QStringLiteral("/profile.json");
+    load();
+}
+
+ProfileStore::~ProfileStore() {
+    flush();
+    s_instance = nullptr;
+}
+
+ProfileStore& ProfileStore::instance() {
+    Q_ASSERT(s_instance);
+    return *s_instance;
+}
+
+void ProfileStore::setGrandCoins(qint64 coins) {
+    if (coins == m_profile.grandCoins) return;
+    m_profile.grandCoins = coins;
+    markDirty();
+}
+
+void ProfileStore::setUnlocks(const QVector<bool>& unlocks) {
+    if (unlocks == m_profile.unlocks) return;
+    m_profile.unlocks = unlocks;
+    markDirty();
+}
+
+void ProfileStore::setSyncedRuns(int runs) {
+    if (runs == m_profile.syncedRuns) return;
+    m_profile.syncedRuns = runs;
+    markDirty();
+}
+
+void ProfileStore::flush() {
+    TRACE_SCOPE("ProfileStore::flush");
+    if (m_dirty) write();
+    m_io.waitForDone();
+}
+
+void ProfileStore::load() {
+    TRACE_SCOPE("ProfileStore::load");
+    QFile f(m_path);
+    if (!f.exists()) {
+        // First run with the JSON store: carry over what QSettings held.
+        if (importSettings()) write();
+        return;
+    }
+    Profile p;
+    if (f.open(QIODevice::ReadOnly) && deserialize(f.readAll(), p)) {
+        m_profile = p;
+        return;
+    }
+    f.close();
+
+    // Starting over from defaults would overwrite the file on the first save,
+    // so keep a copy of it first. If even that fails, never write over it.
+    const QString aside = m_path + QStringLiteral(".bad-")
+                        + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"));
+    if (QFile::copy(m_path, aside)) {
+        qWarning() << "profile: unreadable" << m_path << "- kept a copy as" << aside << "and starting over";
+    } else {
+        m_readOnly = true;
+        qWarning() << "profile: unreadable" << m_path << "and could not be copied aside; progress will not be saved";
+    }
+}
+
+bool ProfileStore::importSettings() {
+    QSettings s("JU","F1PixelGrid");
+    if (s.allKeys().isEmpty()) return false;
+
+    m_profile.grandCoins = s.value("grandCoins", 0).toLongLong();
+    for (const QVariant& u : s.value("unlocks").toList()) m_profile.unlocks.append(u.toBool());
+
+    const int n = s.beginReadArray("leaderboard");
+    for (int i = 0; i < n; ++i) {
+        s.setArrayIndex(i);
+        LeaderboardEntry e;
+        e.stageName = s.value("stage").toString();
+        e.userName  = s.value("user").toString();
+        e.score     = s.value("score").toInt();
+        if (!e.stageName.isEmpty()) m_profile.leaderboard.push_back(e);
+    }
+    s.endArray();
+    return true;
+}
+
+void ProfileStore::markDirty() {
+    m_dirty = true;
+    // Not restarted by later changes, so nothing waits longer than the delay.
+    if (!m_flushTimer.isActive()) m_flushTimer.start(FLUSH_DELAY_MS);
+}
+
+void ProfileStore::write() {
+    m_flushTimer.stop();
+    m_dirty = false;
+    if (m_readOnly) return;
+
+    // The copy shares its containers with m_profile until the GUI thread
+    // changes them again, so taking it is cheap.
+    const Profile snapshot = m_profile;
+    const QString path = m_path;
+    m_io.start([snapshot, path] {
+        TRACE_SCOPE("ProfileStore::save");
+        QSaveFile f(path);
+        if (!f.open(QIODevice::WriteOnly) || f.write(serialize(snapshot)) < 0 || !f.commit())
+            qWarning() << "profile: could not write" << path << f.errorString();
+    });
+}
@@ -0,0 +1,65 @@
+// profilestore.h
+#ifndef PROFILESTORE_H
+#define PROFILESTORE_H
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+#include "scoreboard.h"
+
+// The player's saved progress: coin total and stage unlocks. Loaded once at
+// startup and kept in memory as the source of truth; reads never touch the
+// disk. Changes are written behind: the first change arms a timer and
+// everything changed before it fires goes out in one write, on a worker
+// thread, through a temporary file that is renamed over profile.json.
+// flush() forces any pending write out and waits for it.
+// A profile.json that cannot be read is copied to profile.json.bad-<time>
+// before anything overwrites it.
+// One instance lives for the whole run (see main.cpp). GUI thread only.
+class ProfileStore : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int FLUSH_DELAY_MS = 2000;
+
+    struct Profile {
+        qint64 grandCoins = 0;
+        QVector<bool> unlocks;              // empty until the first save
+        QVector<LeaderboardEntry> leaderboard;  // old best scores; runs now go to RunLog
+        int syncedRuns = 0;                     // runs the leaderboard service has acknowledged
+    };
+
+    explicit ProfileStore(QObject* parent = nullptr);
+    ~ProfileStore();
+
+    static ProfileStore& instance();
+
+    qint64 grandCoins() const { return m_profile.grandCoins; }
+    const QVector<bool>& unlocks() const { return m_profile.unlocks; }
+    const QVector<LeaderboardEntry>& leaderboard() const { return m_profile.leaderboard; }
+    int syncedRuns() const { return m_profile.syncedRuns; }
+
+    void setGrandCoins(qint64 coins);
+    void setUnlocks(const QVector<bool>& unlocks);
+    void setSyncedRuns(int runs);
+
+    void flush();
+
+private:
+    void load();
+    bool importSettings();
+    void markDirty();
+    void write();
+
+    QString m_path;
+    Profile m_profile;
+    bool m_dirty = false;
+    bool m_readOnly = false;                // unreadable file that could not be kept
+    QTimer m_flushTimer;
+    QThreadPool m_io;                       // one thread, so writes land in order
+
+    static ProfileStore* s_instance;
+};
+
+#endif // PROFILESTORE_H
@@ -7,6 +7,8 @@
 #include <random>
 #include <QPainter>
 #include <QHash>
+#include <array>
+#include <limits>
 #include "constants.h"
 
 enum class PropType {
@@ -16,7 +18,8 @@ enum class PropType {
     UFO,
     Rover, Alien,
     // Nightlife Props
-    Building, StreetLamp
+    Building, StreetLamp,
+    Count
 };
 
 struct Prop {
@@ -33,35 +36,59 @@ public:
 
     void maybeSpawnProp(int worldX, int groundGy, int levelIndex, float slope, std::mt19937& rng);
 
-    void draw(QPainter& p, int camX, int camY, int screenW, int screenH, const QHash<int,int>& heightMap);
+    void draw(QPainter& p, int camX, int camY, int screenW, int screenH, const QHash<int,int>& heightMap) const;
 
+    // Drops whole chunks that lie entirely left of minWorldX minus a margin
+    // wide enough for the largest prop.
     void prune(int minWorldX);
     void clear();
+    int count() const;
 
 private:
-    QVector<Prop> m_props;
+    // Props are spawned left to right, so they are bucketed into fixed-width
+    // x-chunks held in one contiguous run: chunk i covers
+    // [i * CHUNK_WIDTH, (i + 1) * CHUNK_WIDTH) and lives at m_chunks[i - m_firstChunk].
+    // Each chunk keeps one list per draw layer so buildings sit behind the rest.
+    enum Layer { BackLayer, FrontLayer, LayerCount };
+    static constexpr int CHUNK_WIDTH  = 1024;
+    static constexpr int PRUNE_MARGIN = 500;
+    static constexpr int NO_PROP      = std::numeric_limits<int>::min();
 
-    void plot(QPainter& p, int gx, int gy, const QColor& c);
+    struct Chunk {
+        std::array<QVector<Prop>, LayerCount> layers;
+    };
+
+    QVector<Chunk> m_chunks;
+    int m_firstChunk = 0;
+    int m_lastSpawnX = NO_PROP;
+    std::array<int, int(PropType::Count)> m_lastOfType;
+
+    static int chunkOf(int wx);
+    void add(const Prop& prop);
+    // True if the most recent prop of this type is closer than `range` to worldX.
+    bool spawnedNear(PropType type, int worldX, int range) const;
+
+    void plot(QPainter& p, int gx, int gy, const QColor& c) const;
 
     // Existing props
-    void drawTree(QPainter& p, int gx, int gy, int worldGX, int wx, int wy, int variant, const QHash<int,int>& heightMap);
-    void drawRock(QPainter& p, int gx, int gy, int variant);
-    void drawFlower(QPainter& p, int gx, int gy, int variant);
-    void drawMushroom(QPainter& p, int gx, int gy, int variant);
-    void drawCactus(QPainter& p, int gx, int gy, int variant);
-    void drawTumbleweed(QPainter& p, int gx, int gy, int variant);
-    void drawCamel(QPainter& p, int gx, int gy, int variant, bool flipped);
-    void drawIgloo(QPainter& p, int gx, int gy, int worldGX, int variant, const QHash<int,int>& heightMap);
-    void drawPenguin(QPainter& p, int gx, int gy, int variant, bool flipped);
-    void drawSnowman(QPainter& p, int gx, int gy, int variant);
-    void drawIceSpike(QPainter& p, int gx, int gy, int variant);
-    void drawUFO(QPainter& p, int gx, int gy, int variant);
-    void drawRover(QPainter& p, int gx, int gy, int worldGX, int variant, bool flipped, const QHash<int,int>& heightMap);
-    void drawAlien(QPainter& p, int gx, int gy, int variant);
+    void drawTree(QPainter& p, int gx, int gy, int worldGX, int wx, int wy, int variant, const QHash<int,int>& heightMap) const;
+    void drawRock(QPainter& p, int gx, int gy, int variant) const;
+    void drawFlower(QPainter& p, int gx, int gy, int variant) const;
+    void drawMushroom(QPainter& p, int gx, int gy, int variant) const;
+    void drawCactus(QPainter& p, int gx, int gy, int variant) const;
+    void drawTumbleweed(QPainter& p, int gx, int gy, int variant) const;
+    void drawCamel(QPainter& p, int gx, int gy, int variant, bool flipped) const;
+    void drawIgloo(QPainter& p, int gx, int gy, int worldGX, int variant, const QHash<int,int>& heightMap) const;
+    void drawPenguin(QPainter& p, int gx, int gy, int variant, bool flipped) const;
+    void drawSnowman(QPainter& p, int gx, int gy, int variant) const;
+    void drawIceSpike(QPainter& p, int gx, int gy, int variant) const;
+    void drawUFO(QPainter& p, int gx, int gy, int variant) const;
+    void drawRover(QPainter& p, int gx, int gy, int worldGX, int variant, bool flipped, const QHash<int,int>& heightMap) const;
+    void drawAlien(QPainter& p, int gx, int gy, int variant) const;
 
     // Nightlife Drawing Functions
-    void drawBuilding(QPainter& p, int gx, int gy, int worldGX, int variant, const QHash<int,int>& heightMap);
-    void drawStreetLamp(QPainter& p, int gx, int gy, int worldGX, int variant, const QHash<int,int>& heightMap);
+    void drawBuilding(QPainter& p, int gx, int gy, int worldGX, int variant, const QHash<int,int>& heightMap) const;
+    void drawStreetLamp(QPainter& p, int gx, int gy, int worldGX, int variant, const QHash<int,int>& heightMap) const;
 };
 
 #endif // PROP_H
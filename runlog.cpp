@@ -0,0 +1,168 @@
+// runlog.cpp
+#include "runlog.h"
+#include "trace.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// File layout: Header, then native-endian RunRecords back to back.
+struct Header {
+    char    magic[4];
+    quint32 version;
+    quint32 recordSize;
+    quint32 reserved;
+};
+static_assert(sizeof(Header) == 16, "on-disk header layout");
+
+constexpr char    MAGIC[4] = {'B', 'B', 'R', 'L'};
+constexpr quint32 VERSION  = 1;
+
+} // namespace
+
+RunLog::RunLog(const QString& path) {
+    m_io.setMaxThreadCount(1);
+    open(path);
+}
+
+RunLog::~RunLog() {
+    m_io.waitForDone();
+}
+
+void RunLog::open(const QString& path) {
+    TRACE_SCOPE("RunLog::open");
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    m_file.setFileName(path);
+    m_new = !m_file.exists();
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "runlog: cannot open" << path << m_file.errorString();
+        return;
+    }
+
+    Header h{};
+    const bool valid = m_file.read(reinterpret_cast<char*>(&h), sizeof h) == qint64(sizeof h)
+                    && std::memcmp(h.magic, MAGIC, sizeof MAGIC) == 0
+                    && h.version == VERSION && h.recordSize == sizeof(RunRecord);
+    if (!valid) {
+        if (!m_new && m_file.size() > 0) {
+            // Truncating would lose every recorded run, so keep a copy first.
+            // If even that fails, leave the file alone for this session.
+            m_file.close();
+            const QString aside = path + QStringLiteral(".bad-")
+                                + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"));
+            if (!QFile::copy(path, aside)) {
+                qWarning() << "runlog: unreadable" << path << "and could not be copied aside; runs will not be saved";
+                m_file.open(QIODevice::ReadOnly);
+                return;
+            }
+            qWarning() << "runlog: unreadable" << path << "- kept a copy as" << aside << "and starting over";
+            if (!m_file.open(QIODevice::ReadWrite)) {
+                qWarning() << "runlog: cannot open" << path << m_file.errorString();
+                return;
+            }
+        }
+        std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+        h.version = VERSION;
+        h.recordSize = sizeof(RunRecord);
+        h.reserved = 0;
+        m_file.resize(0);
+        m_file.seek(0);
+        m_file.write(reinterpret_cast<const char*>(&h), sizeof h);
+        m_file.flush();
+        return;
+    }
+
+    const qint64 count = (m_file.size() - qint64(sizeof h)) / qint64(sizeof(RunRecord));
+    const qint64 end = qint64(sizeof h) + count * qint64(sizeof(RunRecord));
+    if (m_file.size() != end) m_file.resize(end);
+
+    m_records.resize(count);
+    const qint64 bytes = count * qint64(sizeof(RunRecord));
+    if (m_file.read(reinterpret_cast<char*>(m_records.data()), bytes) != bytes) {
+        qWarning() << "runlog: short read" << path;
+        m_records.clear();
+    }
+    // Sort each stage once rather than inserting run by run.
+    for (quint32 i = 0; i < quint32(m_records.size()); ++i) {
+        const RunRecord& r = m_records[i];
+        if (r.stage >= m_stages.size()) continue;
+        m_stages[r.stage].byScore.push_back(i);
+        m_stages[r.stage].byTime.push_back(i);
+    }
+    for (StageIndex& s : m_stages) {
+        std::stable_sort(s.byScore.begin(), s.byScore.end(),
+                         [this](quint32 a, quint32 b) { return m_records[a].score > m_records[b].score; });
+    }
+    m_file.seek(m_file.size());
+}
+
+void RunLog::append(const RunRecord& run) {
+    TRACE_SCOPE("RunLog::append");
+    if (run.stage >= m_stages.size()) return;
+    if (m_file.isWritable()) {
+        m_io.start([this, run] {
+            TRACE_SCOPE("RunLog::write");
+            m_file.seek(m_file.size());
+            if (m_file.write(reinterpret_cast<const char*>(&run), sizeof run) != qint64(sizeof run)
+                || !m_file.flush()) {
+                qWarning() << "runlog: append failed" << m_file.errorString();
+            }
+        });
+    }
+    m_records.push_back(run);
+    index(quint32(m_records.size() - 1));
+}
+
+void RunLog::index(quint32 record) {
+    const RunRecord& r = m_records[record];
+    if (r.stage >= m_stages.size()) return;
+    StageIndex& s = m_stages[r.stage];
+
+    // Runs with the score being inserted stay ahead of it.
+    const auto at = std::upper_bound(s.byScore.begin(), s.byScore.end(), r.score,
+                                     [this](qint32 score, quint32 i) { return score > m_records[i].score; });
+    s.byScore.insert(at, record);
+    s.byTime.push_back(record);
+}
+
+const RunLog::StageIndex* RunLog::stageIndex(int stage) const {
+    if (stage < 0 || stage >= int(m_stages.size())) return nullptr;
+    return &m_stages[stage];
+}
+
+int RunLog::runCount(int stage) const {
+    const StageIndex* s = stageIndex(stage);
+    return s ? s->byTime.size() : 0;
+}
+
+QVector<RunRecord> RunLog::topRuns(int stage, int n) const {
+    QVector<RunRecord> out;
+    const StageIndex* s = stageIndex(stage);
+    if (!s) return out;
+    const int k = std::min(n, int(s->byScore.size()));
+    out.reserve(k);
+    for (int i = 0; i < k; ++i) out.push_back(m_records[s->byScore[i]]);
+    return out;
+}
+
+QVector<RunRecord> RunLog::recentRuns(int stage, int n) const {
+    QVector<RunRecord> out;
+    const StageIndex* s = stageIndex(stage);
+    if (!s) return out;
+    const int k = std::min(n, int(s->byTime.size()));
+    out.reserve(k);
+    for (int i = 0; i < k; ++i) out.push_back(m_records[s->byTime[s->byTime.size() - 1 - i]]);
+    return out;
+}
+
+int RunLog::percentile(int stage, int score) const {
+    const StageIndex* s = stageIndex(stage);
+    if (!s || s->byScore.isEmpty()) return 0;
+    const auto below = std::partition_point(s->byScore.begin(), s->byScore.end(),
+                                            [&](quint32 i) { return m_records[i].score >= score; });
+    return int(qint64(s->byScore.end() - below) * 100 / s->byScore.size());
+}
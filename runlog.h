@@ -0,0 +1,74 @@
+// runlog.h
+#ifndef RUNLOG_H
+#define RUNLOG_H
+
+#include <QFile>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <QtGlobal>
+#include <array>
+#include "constants.h"
+
+// One finished run, stored verbatim as a fixed-size record.
+struct RunRecord {
+    qint64  endedAtMs  = 0;     // ms since the epoch; 0 for runs imported from the old scoreboard
+    quint32 seed       = 0;     // terrain RNG seed of the run
+    qint32  score      = 0;
+    qint32  distanceDm = 0;     // decimetres
+    quint32 durationMs = 0;
+    qint32  coins      = 0;
+    qint16  flips      = 0;
+    qint16  nitroUses  = 0;
+    quint8  stage      = 0;     // index into Constants::LEVELS
+    quint8  reserved[7] = {};
+};
+static_assert(sizeof(RunRecord) == 40, "on-disk record layout");
+
+// Append-only history of every run, one RunRecord per run after a small
+// header. The log is read once on open; afterwards each run costs one append,
+// written behind on a worker thread like ProfileStore's saves.
+// A per-stage index (runs sorted by score, and in finishing order) answers the
+// top-N, percentile and recent-run queries without walking the whole history.
+// A record cut short by a crash is dropped when the log is next opened; a log
+// with a bad header is copied to runs.log.bad-<time> before it is started over.
+class RunLog {
+public:
+    explicit RunLog(const QString& path);
+    ~RunLog();
+
+    // True if the log did not exist before this instance created it.
+    bool isNew() const { return m_new; }
+
+    void append(const RunRecord& run);
+
+    // Every run in the log, oldest first.
+    int size() const { return m_records.size(); }
+    const RunRecord& at(int i) const { return m_records[i]; }
+
+    int runCount(int stage) const;
+    // Best first; ties keep the earlier run first.
+    QVector<RunRecord> topRuns(int stage, int n) const;
+    // Newest first.
+    QVector<RunRecord> recentRuns(int stage, int n) const;
+    // Share of the stage's runs that scored below score, 0..100.
+    int percentile(int stage, int score) const;
+
+private:
+    struct StageIndex {
+        QVector<quint32> byScore;   // record numbers, score descending
+        QVector<quint32> byTime;    // record numbers, oldest first
+    };
+
+    void open(const QString& path);
+    void index(quint32 record);
+    const StageIndex* stageIndex(int stage) const;
+
+    QFile m_file;                           // only touched from m_io after open()
+    bool m_new = false;
+    QVector<RunRecord> m_records;
+    std::array<StageIndex, Constants::LEVEL_COUNT> m_stages;
+    QThreadPool m_io;                       // one thread, so appends land in order
+};
+
+#endif // RUNLOG_H
@@ -1,12 +1,13 @@
 #include "scoreboard.h"
+#include "profilestore.h"
+#include "constants.h"
+#include "leaderboardsync.h"
 #include <QPainter>
 #include <QPaintEvent>
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QPalette>
-#include <QSysInfo>
-#include <QSettings>
-#include <algorithm>
+#include <QStandardPaths>
 
 LeaderboardWidget::LeaderboardWidget(QWidget* parent) : QWidget(parent)
 {
@@ -71,7 +72,11 @@ void LeaderboardWidget::paintEvent(QPaintEvent* event)
     const int rowHeight = 26;
 
     int colStageX = panel.left() + 40;
-    int colScoreX = panel.right() - 160;
+    int colScoreX = panel.left() + panel.width() * 3 / 10;
+    int colRunsX  = colScoreX + panel.width() / 6;
+    int colLastX  = colRunsX + panel.width() / 9;
+    int colPctX   = colLastX + panel.width() / 9;
+    int colWorldX = colPctX + panel.width() / 9;
 
     // Header row
     p.setFont(headerFont);
@@ -79,6 +84,10 @@ void LeaderboardWidget::paintEvent(QPaintEvent* event)
     int headerY = panel.top() + topMargin;
     p.drawText(colStageX, headerY, QStringLiteral("STAGE"));
     p.drawText(colScoreX, headerY, QStringLiteral("BEST SCORE"));
+    p.drawText(colRunsX,  headerY, QStringLiteral("RUNS"));
+    p.drawText(colLastX,  headerY, QStringLiteral("LAST"));
+    p.drawText(colPctX,   headerY, QStringLiteral("BEATS"));
+    p.drawText(colWorldX, headerY, QStringLiteral("WORLD"));
 
 
     // Separator line
@@ -113,6 +122,10 @@ void LeaderboardWidget::paintEvent(QPaintEvent* event)
         p.setPen(QColor(220, 220, 230));
         p.drawText(colStageX, y, e.stageName);
         p.drawText(colScoreX, y, QString::number(e.score));
+        p.drawText(colRunsX,  y, QString::number(e.runs));
+        p.drawText(colLastX,  y, QString::number(e.lastScore));
+        p.drawText(colPctX,   y, QStringLiteral("%1%").arg(e.lastPercentile));
+        p.drawText(colWorldX, y, e.worldBest >= 0 ? QString::number(e.worldBest) : QStringLiteral("-"));
 
         y += rowHeight;
         if (y > panel.bottom() - 20) break;
@@ -152,98 +165,65 @@ void LeaderboardWidget::mousePressEvent(QMouseEvent* event)
 
 LeaderboardManager::LeaderboardManager(QObject* parent)
     : QObject(parent)
+    , m_log(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QStringLiteral("/runs.log"))
 {
-    loadFromSettings();
+    if (m_log.isNew()) importProfileScores();
+
+    m_sync = LeaderboardSync::fromEnvironment(m_log, this);
+    if (m_sync) {
+        connect(m_sync, &LeaderboardSync::remoteUpdated, this, &LeaderboardManager::refreshCached);
+    }
 }
 
-QString LeaderboardManager::deviceId() const
+void LeaderboardManager::submitRun(const RunRecord& run)
 {
-    QByteArray id = QSysInfo::machineUniqueId();
-    if (!id.isEmpty())
-        return QString::fromLatin1(id.toHex());
-
-    QString host = QSysInfo::machineHostName();
-    if (!host.isEmpty())
-        return host;
-
-    return QStringLiteral("UNKNOWN_DEVICE");
+    m_log.append(run);
+    if (m_sync) m_sync->runsAppended();
+    emit leaderboardUpdated(entries());
 }
 
-void LeaderboardManager::submitScore(const QString& stageName, int score)
+void LeaderboardManager::refreshLeaderboard()
 {
-    const QString user = deviceId();
-
-    // Update local entries: keep only best score per (stage, user)
-    bool found = false;
-    for (auto &e : m_entries) {
-        if (e.stageName == stageName && e.userName == user) {
-            if (score > e.score)
-                e.score = score;
-            found = true;
-            break;
-        }
-    }
-
-    if (!found) {
-        LeaderboardEntry e;
-        e.stageName = stageName;
-        e.userName  = user;
-        e.score     = score;
-        m_entries.push_back(e);
-    }
-
-    std::sort(m_entries.begin(), m_entries.end(),
-              [](const LeaderboardEntry& a, const LeaderboardEntry& b) {
-                  if (a.stageName == b.stageName)
-                      return a.score > b.score;
-                  return a.stageName < b.stageName;
-              });
-
-    saveToSettings();
-    emit leaderboardUpdated(m_entries);
+    refreshCached();
+    if (m_sync) m_sync->fetchBest();
 }
 
-void LeaderboardManager::refreshLeaderboard()
+void LeaderboardManager::refreshCached()
 {
-    emit leaderboardUpdated(m_entries);
+    emit leaderboardUpdated(entries());
 }
 
-void LeaderboardManager::loadFromSettings()
+QVector<LeaderboardEntry> LeaderboardManager::entries() const
 {
-    m_entries.clear();
+    QVector<LeaderboardEntry> out;
+    for (int stage = 0; stage < Constants::LEVEL_COUNT; ++stage) {
+        const QVector<RunRecord> best = m_log.topRuns(stage, 1);
+        if (best.isEmpty()) continue;
+        const QVector<RunRecord> last = m_log.recentRuns(stage, 1);
 
-    QSettings s("JU", "F1PixelGrid");
-    int n = s.beginReadArray("leaderboard");
-    for (int i = 0; i < n; ++i) {
-        s.setArrayIndex(i);
         LeaderboardEntry e;
-        e.stageName = s.value("stage").toString();
-        e.userName  = s.value("user").toString();
-        e.score     = s.value("score").toInt();
-        if (!e.stageName.isEmpty())
-            m_entries.push_back(e);
+        e.stageName      = Constants::LEVELS[stage].displayName();
+        e.score          = best.front().score;
+        e.runs           = m_log.runCount(stage);
+        e.lastScore      = last.front().score;
+        e.lastPercentile = m_log.percentile(stage, e.lastScore);
+        e.worldBest      = m_sync ? m_sync->remoteBest(stage) : -1;
+        out.push_back(e);
     }
-    s.endArray();
-
-    // Ensure deterministic ordering
-    std::sort(m_entries.begin(), m_entries.end(),
-              [](const LeaderboardEntry& a, const LeaderboardEntry& b) {
-                  if (a.stageName == b.stageName)
-                      return a.score > b.score;
-                  return a.stageName < b.stageName;
-              });
+    return out;
 }
 
-void LeaderboardManager::saveToSettings() const
+// Best scores kept by the old per-device scoreboard become undated runs.
+void LeaderboardManager::importProfileScores()
 {
-    QSettings s("JU", "F1PixelGrid");
-    s.beginWriteArray("leaderboard");
-    for (int i = 0; i < m_entries.size(); ++i) {
-        s.setArrayIndex(i);
-        s.setValue("stage", m_entries[i].stageName);
-        s.setValue("user",  m_entries[i].userName);
-        s.setValue("score", m_entries[i].score);
+    for (const LeaderboardEntry& e : ProfileStore::instance().leaderboard()) {
+        for (int stage = 0; stage < Constants::LEVEL_COUNT; ++stage) {
+            if (Constants::LEVELS[stage].displayName() != e.stageName) continue;
+            RunRecord r;
+            r.stage = quint8(stage);
+            r.score = e.score;
+            m_log.append(r);
+            break;
+        }
     }
-    s.endArray();
-    s.sync();
 }
@@ -4,6 +4,9 @@
 #include <QWidget>
 #include <QVector>
 #include <QString>
+#include "runlog.h"
+
+class LeaderboardSync;
 
 class QPaintEvent;
 class QKeyEvent;
@@ -14,6 +17,10 @@ struct LeaderboardEntry {
     QString stageName;   // e.g. "MEADOW", "NIGHTLIFE"
     QString userName;    // device id (for storage only; no longer drawn)
     int     score = 0;   // best score on that stage
+    int     runs = 0;
+    int     lastScore = 0;
+    int     lastPercentile = 0;  // share of the stage's runs the last one beat
+    int     worldBest = -1;      // best on the leaderboard service, -1 if unknown
 };
 
 // -----------------------------------------------------------------------------
@@ -39,7 +46,7 @@ private:
 };
 
 // -----------------------------------------------------------------------------
-// Scoreboard manager (LOCAL, per-player)
+// Scoreboard manager (reads the run log; optionally synced, see LeaderboardSync)
 // -----------------------------------------------------------------------------
 class LeaderboardManager : public QObject {
     Q_OBJECT
@@ -47,18 +54,20 @@ public:
     explicit LeaderboardManager(QObject* parent = nullptr);
 
     // Call this after each game ends
-    void submitScore(const QString& stageName, int score);
+    void submitRun(const RunRecord& run);
 
-    // Call this when opening the scoreboard (press L)
+    // Call this when opening the scoreboard (press S). Emits the cached board
+    // right away and again once the service answers.
     void refreshLeaderboard();
 
 signals:
     void leaderboardUpdated(const QVector<LeaderboardEntry>& entries);
 
 private:
-    QString deviceId() const;
-    void    loadFromSettings();
-    void    saveToSettings() const;
+    void refreshCached();
+    QVector<LeaderboardEntry> entries() const;
+    void importProfileScores();
 
-    QVector<LeaderboardEntry> m_entries;
+    RunLog m_log;
+    LeaderboardSync* m_sync = nullptr;      // null when no service is configured
 };
@@ -0,0 +1,35 @@
+// stagepaths.cpp
+#include "stagepaths.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace {
+
+template <int Level>
+void stepCar(const QList<Wheel*>& wheels, const QList<CarBody*>& bodies, const QList<Line>& lines,
+             bool accelerating, bool braking, bool nitro)
+{
+    for (Wheel* w : wheels) w->simulate<Level>(lines, accelerating, braking, nitro);
+    for (CarBody* b : bodies) b->simulate<Level>(lines, accelerating, braking);
+}
+
+template <int Level>
+constexpr StagePaths makePaths() {
+    return { &stepCar<Level>,
+             Constants::LEVEL_RENDER[Level].highway ? &shadeTerrainRow<true> : &shadeTerrainRow<false> };
+}
+
+template <std::size_t... L>
+constexpr std::array<StagePaths, sizeof...(L)> makeTable(std::index_sequence<L...>) {
+    return {{ makePaths<int(L)>()... }};
+}
+
+const std::array<StagePaths, Constants::LEVEL_COUNT> PATHS =
+    makeTable(std::make_index_sequence<Constants::LEVEL_COUNT>{});
+
+} // namespace
+
+const StagePaths& StagePaths::forLevel(int levelIndex) {
+    return PATHS[std::clamp(levelIndex, 0, Constants::LEVEL_COUNT - 1)];
+}
@@ -0,0 +1,23 @@
+// stagepaths.h
+#ifndef STAGEPATHS_H
+#define STAGEPATHS_H
+
+#include <QList>
+#include "carBody.h"
+#include "line.h"
+#include "terrainkernel.h"
+#include "wheel.h"
+
+// Hot paths compiled once per biome with that biome's constants folded in
+// (Constants::LEVEL_PHYSICS / LEVEL_RENDER). MainWindow picks the entry for the
+// stage when it starts, so the per-tick and per-cell code never looks at the
+// level index again.
+struct StagePaths {
+    void (*stepCar)(const QList<Wheel*>& wheels, const QList<CarBody*>& bodies, const QList<Line>& lines,
+                    bool accelerating, bool braking, bool nitro);
+    TerrainShadeFn shadeTerrain;
+
+    static const StagePaths& forLevel(int levelIndex);
+};
+
+#endif // STAGEPATHS_H
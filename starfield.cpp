@@ -0,0 +1,60 @@
+// starfield.cpp
+#include "starfield.h"
+#include <algorithm>
+
+void StarField::setDensity(double chancePerBlock) {
+    if (chancePerBlock == m_density) return;
+    m_density = chancePerBlock;
+    const double c = std::clamp(chancePerBlock, 0.0, 1.0);
+    m_threshold = quint32(c * 4294967295.0);
+    m_tiles.clear();
+}
+
+void StarField::clear() {
+    m_tiles.clear();
+    m_tx1 = m_tx0 - 1;
+    m_ty1 = m_ty0 - 1;
+}
+
+QVector<StarField::Star> StarField::buildTile(int tx, int ty) const {
+    QVector<Star> stars;
+    const int bx0 = tx * TILE_BLOCKS;
+    const int by0 = ty * TILE_BLOCKS;
+
+    for (int by = by0; by < by0 + TILE_BLOCKS; ++by) {
+        for (int bx = bx0; bx < bx0 + TILE_BLOCKS; ++bx) {
+            if (hash(bx, by, 0) >= m_threshold) continue;
+            Star s;
+            s.wgx   = bx * BLOCK + int(hash(bx, by, 1) % BLOCK);
+            s.wgy   = by * BLOCK + int(hash(bx, by, 2) % BLOCK);
+            s.alpha = 100 + int(hash(bx, by, 3) % 156);
+            stars.append(s);
+        }
+    }
+    return stars;
+}
+
+void StarField::prepare(int worldGX0, int worldGY0, int worldGX1, int worldGY1) {
+    m_gx0 = worldGX0; m_gx1 = worldGX1;
+    m_gy0 = worldGY0; m_gy1 = worldGY1;
+
+    m_tx0 = floorDiv(worldGX0, TILE_CELLS);
+    m_tx1 = floorDiv(worldGX1, TILE_CELLS);
+    m_ty0 = floorDiv(worldGY0, TILE_CELLS);
+    m_ty1 = floorDiv(worldGY1, TILE_CELLS);
+
+    for (int ty = m_ty0; ty <= m_ty1; ++ty) {
+        for (int tx = m_tx0; tx <= m_tx1; ++tx) {
+            const qint64 key = tileKey(tx, ty);
+            if (!m_tiles.contains(key)) m_tiles.insert(key, buildTile(tx, ty));
+        }
+    }
+
+    // Keep a one-tile margin so small camera jitter does not thrash the cache.
+    for (auto it = m_tiles.begin(); it != m_tiles.end(); ) {
+        const int tx = int(it.key() >> 32);
+        const int ty = int(qint32(quint32(it.key() & 0xFFFFFFFF)));
+        if (tx < m_tx0 - 1 || tx > m_tx1 + 1 || ty < m_ty0 - 1 || ty > m_ty1 + 1) it = m_tiles.erase(it);
+        else ++it;
+    }
+}
@@ -0,0 +1,73 @@
+// starfield.h
+#ifndef STARFIELD_H
+#define STARFIELD_H
+
+#include <QHash>
+#include <QVector>
+#include <QtGlobal>
+
+// Procedural star layer shared by the game and the intro screen.
+// Star placement is a pure function of the 20x20 block coordinate (counter-based
+// hash, no generator state), and blocks are grouped into world-aligned tiles that
+// are generated once when they scroll into view and dropped once they leave it.
+class StarField {
+public:
+    struct Star {
+        int wgx;
+        int wgy;
+        int alpha;
+    };
+
+    static constexpr int BLOCK       = 20;
+    static constexpr int TILE_BLOCKS = 8;
+    static constexpr int TILE_CELLS  = BLOCK * TILE_BLOCKS;
+
+    // Chance that a block holds a star. Changing it invalidates every tile.
+    void setDensity(double chancePerBlock);
+    void clear();
+
+    // Builds the tiles overlapping the world-cell rectangle and evicts the ones
+    // that are out of view. Must be called before forEachVisible() each frame.
+    void prepare(int worldGX0, int worldGY0, int worldGX1, int worldGY1);
+
+    template <typename Fn>
+    void forEachVisible(Fn&& fn) const {
+        for (int ty = m_ty0; ty <= m_ty1; ++ty) {
+            for (int tx = m_tx0; tx <= m_tx1; ++tx) {
+                auto it = m_tiles.constFind(tileKey(tx, ty));
+                if (it == m_tiles.constEnd()) continue;
+                for (const Star& s : it.value()) {
+                    if (s.wgx < m_gx0 || s.wgx > m_gx1 || s.wgy < m_gy0 || s.wgy > m_gy1) continue;
+                    fn(s);
+                }
+            }
+        }
+    }
+
+    static inline quint32 hash(int x, int y, quint32 counter) {
+        quint32 h = quint32(x) * 0x9E3779B1u;
+        h ^= quint32(y) * 0x85EBCA77u + counter * 0xC2B2AE3Du;
+        h ^= h >> 16; h *= 0x7FEB352Du;
+        h ^= h >> 15; h *= 0x846CA68Bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+private:
+    static inline qint64 tileKey(int tx, int ty) {
+        return (qint64(tx) << 32) | quint32(ty);
+    }
+    static inline int floorDiv(int a, int b) {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+    QVector<Star> buildTile(int tx, int ty) const;
+
+    QHash<qint64, QVector<Star>> m_tiles;
+    double m_density = -1.0;
+    quint32 m_threshold = 0;
+
+    int m_tx0 = 0, m_tx1 = -1, m_ty0 = 0, m_ty1 = -1;
+    int m_gx0 = 0, m_gx1 = -1, m_gy0 = 0, m_gy1 = -1;
+};
+
+#endif // STARFIELD_H
@@ -0,0 +1,39 @@
+// startuptrace.cpp
+#include "startuptrace.h"
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QVector>
+#include <QPair>
+#include <QDebug>
+#include <QtGlobal>
+#include <cstring>
+
+namespace {
+QElapsedTimer s_clock;
+QVector<QPair<const char*, qint64>> s_marks;
+bool s_reported = false;
+}
+
+void StartupTrace::start() {
+    s_clock.start();
+}
+
+void StartupTrace::mark(const char* milestone) {
+    if (!s_clock.isValid()) return;
+    for (const auto& m : s_marks) {
+        if (std::strcmp(m.first, milestone) == 0) return;
+    }
+    s_marks.append(qMakePair(milestone, s_clock.elapsed()));
+}
+
+void StartupTrace::report() {
+    if (s_reported || s_marks.isEmpty()) return;
+    s_reported = true;
+    bool ok = false;
+    if (qEnvironmentVariableIntValue("BB_STARTUP_TRACE", &ok) == 0 && ok) return;
+
+    QStringList parts;
+    for (const auto& m : s_marks)
+        parts << QStringLiteral("%1 %2 ms").arg(QLatin1String(m.first)).arg(m.second);
+    qInfo().noquote() << "startup:" << parts.join(QStringLiteral(", "));
+}
@@ -0,0 +1,14 @@
+// startuptrace.h
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+// Milliseconds from the top of main() to named startup milestones. Only the
+// first mark() of each milestone counts; report() prints them as one line on
+// the debug output (set BB_STARTUP_TRACE=0 to silence it). GUI thread only.
+namespace StartupTrace {
+    void start();
+    void mark(const char* milestone);
+    void report();
+}
+
+#endif // STARTUPTRACE_H
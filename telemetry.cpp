@@ -0,0 +1,183 @@
+// telemetry.cpp
+#include "telemetry.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <climits>
+#include <csignal>
+#include <cstring>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// File layout: Header, then `count` native-endian TelemetryFrames, oldest first.
+struct Header {
+    char    magic[4];
+    quint32 version;
+    quint32 frameSize;
+    quint32 count;
+};
+static_assert(sizeof(Header) == 16, "dump header layout");
+
+constexpr char    MAGIC[4] = {'B', 'B', 'T', 'L'};
+constexpr quint32 VERSION  = 1;
+
+Header headerFor(quint32 count) {
+    Header h{};
+    std::memcpy(h.magic, MAGIC, sizeof MAGIC);
+    h.version = VERSION;
+    h.frameSize = sizeof(TelemetryFrame);
+    h.count = count;
+    return h;
+}
+
+// The two contiguous spans of the ring, oldest first.
+struct Spans { const TelemetryFrame* a; quint32 na; const TelemetryFrame* b; quint32 nb; };
+
+Spans spans(const TelemetryFrame* slots, quint32 written) {
+    const quint32 cap = Telemetry::CAPACITY;
+    if (written <= cap) return { slots, written, nullptr, 0 };
+    const quint32 head = written & (cap - 1);
+    return { slots + head, cap - head, slots, head };
+}
+
+// Crash dump state; the handler may only read these.
+const Telemetry*      s_crashRing = nullptr;
+const TelemetryFrame* s_crashSlots = nullptr;
+const quint32*        s_crashWritten = nullptr;
+char s_crashPath[1024] = {};
+
+#if defined(Q_OS_WIN)
+int  openForDump(const char* p) { return _open(p, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE); }
+void writeAll(int fd, const void* d, size_t n) {
+    // _write takes an unsigned count, so large writes go out in INT_MAX pieces.
+    const char* c = static_cast<const char*>(d);
+    while (n > 0) {
+        const int w = _write(fd, c, unsigned(std::min<size_t>(n, INT_MAX)));
+        if (w <= 0) return;
+        c += w;
+        n -= size_t(w);
+    }
+}
+void closeDump(int fd) { _close(fd); }
+#else
+int  openForDump(const char* p) { return ::open(p, O_WRONLY | O_CREAT | O_TRUNC, 0644); }
+void writeAll(int fd, const void* d, size_t n) {
+    const char* c = static_cast<const char*>(d);
+    while (n > 0) {
+        const ssize_t w = ::write(fd, c, n);
+        if (w <= 0) return;
+        c += w;
+        n -= size_t(w);
+    }
+}
+void closeDump(int fd) { ::close(fd); }
+#endif
+
+extern "C" void crashDump(int sig) {
+    std::signal(sig, SIG_DFL);
+    const int fd = openForDump(s_crashPath);
+    if (fd >= 0) {
+        const Spans s = spans(s_crashSlots, *s_crashWritten);
+        const Header h = headerFor(s.na + s.nb);
+        writeAll(fd, &h, sizeof h);
+        writeAll(fd, s.a, s.na * sizeof(TelemetryFrame));
+        if (s.nb) writeAll(fd, s.b, s.nb * sizeof(TelemetryFrame));
+        closeDump(fd);
+    }
+    std::raise(sig);
+}
+
+} // namespace
+
+Telemetry::Telemetry() : m_ring(CAPACITY) {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+    m_slots = m_ring.data();
+    m_clock.start();
+}
+
+Telemetry::~Telemetry() {
+    if (s_crashRing == this) {
+        for (int sig : { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) std::signal(sig, SIG_DFL);
+        s_crashRing = nullptr;
+    }
+}
+
+void Telemetry::record(const TelemetryFrame& f) {
+    TelemetryFrame& slot = m_slots[m_written & (CAPACITY - 1)];
+    slot = f;
+    slot.frame = m_written;
+    ++m_written;
+}
+
+bool Telemetry::dump(const QString& path) const {
+    const Spans s = spans(m_slots, m_written);
+    const Header h = headerFor(s.na + s.nb);
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+    f.write(reinterpret_cast<const char*>(&h), sizeof h);
+    f.write(reinterpret_cast<const char*>(s.a), qint64(s.na) * qint64(sizeof(TelemetryFrame)));
+    if (s.nb) f.write(reinterpret_cast<const char*>(s.b), qint64(s.nb) * qint64(sizeof(TelemetryFrame)));
+    return f.commit();
+}
+
+void Telemetry::installCrashHandler(const QString& path) {
+    const QByteArray native = QFile::encodeName(path);
+    if (native.size() >= int(sizeof s_crashPath)) return;
+    std::memcpy(s_crashPath, native.constData(), size_t(native.size()) + 1);
+    s_crashSlots = m_slots;
+    s_crashWritten = &m_written;
+    s_crashRing = this;
+    for (int sig : { SIGSEGV, SIGABRT, SIGFPE, SIGILL }) std::signal(sig, crashDump);
+}
+
+bool Telemetry::writeCsv(const QString& dumpPath, const QString& csvPath) {
+    QFile in(dumpPath);
+    if (!in.open(QIODevice::ReadOnly)) {
+        qCritical().noquote() << "telemetry: cannot open" << dumpPath;
+        return false;
+    }
+    Header h{};
+    if (in.read(reinterpret_cast<char*>(&h), sizeof h) != qint64(sizeof h)
+        || std::memcmp(h.magic, MAGIC, sizeof MAGIC) != 0
+        || h.version != VERSION || h.frameSize != sizeof(TelemetryFrame)) {
+        qCritical().noquote() << "telemetry:" << dumpPath << "is not a telemetry dump";
+        return false;
+    }
+
+    QSaveFile out(csvPath);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCritical().noquote() << "telemetry: cannot write" << csvPath;
+        return false;
+    }
+    QTextStream ts(&out);
+    ts.setRealNumberPrecision(9);
+    ts << "t_s,frame,dt_ms,sim_ms,render_ms,x,y,vx,vy,fuel,segments,coins,cans,props,"
+          "accel,brake,nitro_key,nitro_active\n";
+
+    TelemetryFrame f;
+    for (quint32 i = 0; i < h.count; ++i) {
+        if (in.read(reinterpret_cast<char*>(&f), sizeof f) != qint64(sizeof f)) break;
+        ts << f.tNs / 1e9 << ',' << f.frame << ','
+           << f.dtMs << ',' << f.simMs << ',' << f.renderMs << ','
+           << f.x << ',' << f.y << ',' << f.vx << ',' << f.vy << ',' << f.fuel << ','
+           << f.segments << ',' << f.coins << ',' << f.cans << ',' << f.props << ','
+           << int(bool(f.inputs & TelemetryFrame::Accel)) << ','
+           << int(bool(f.inputs & TelemetryFrame::Brake)) << ','
+           << int(bool(f.inputs & TelemetryFrame::NitroKey)) << ','
+           << int(bool(f.inputs & TelemetryFrame::NitroActive)) << '\n';
+    }
+    ts.flush();
+    return out.commit();
+}
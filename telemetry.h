@@ -0,0 +1,63 @@
+// telemetry.h
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// One game-loop tick, written verbatim into the ring and into dumps.
+struct TelemetryFrame {
+    qint64  tNs = 0;            // since the ring was created
+    quint32 frame = 0;          // running tick number
+    float   dtMs = 0;           // wall time since the previous tick
+    float   simMs = 0;          // time spent in the tick itself
+    float   renderMs = 0;       // the most recent paintEvent
+    float   x = 0, y = 0;       // car body position, world px
+    float   vx = 0, vy = 0;     // mean wheel velocity
+    float   fuel = 0;
+    quint32 segments = 0;       // live terrain segments
+    quint16 coins = 0, cans = 0, props = 0;
+    quint8  inputs = 0;         // Input bits
+    quint8  reserved = 0;
+
+    enum Input : quint8 { Accel = 1, Brake = 2, NitroKey = 4, NitroActive = 8 };
+};
+static_assert(sizeof(TelemetryFrame) == 56, "dump record layout");
+
+// Always-on flight recorder: the last CAPACITY ticks (about 40 s at the
+// 10 ms game timer) in a ring allocated once up front, so recording a tick
+// is a plain struct copy. dump() writes the ring oldest first to a binary
+// file; installCrashHandler() does the same from a fatal-signal handler using
+// only async-signal-safe calls. writeCsv() converts a dump for plotting
+// (main.cpp runs it for --telemetry-csv).
+class Telemetry {
+public:
+    static constexpr int CAPACITY = 4096;  // power of two
+
+    Telemetry();
+    ~Telemetry();
+
+    qint64 nowNs() const { return m_clock.nsecsElapsed(); }
+    void record(const TelemetryFrame& f);
+    void setRenderMs(float ms) { m_renderMs = ms; }
+    float renderMs() const { return m_renderMs; }
+
+    bool dump(const QString& path) const;
+    // Dumps to path if the process dies on SIGSEGV, SIGABRT, SIGFPE or SIGILL.
+    void installCrashHandler(const QString& path);
+
+    // Writes a dump as CSV with a header row; false (with a message on
+    // stderr) if the input is not a telemetry dump.
+    static bool writeCsv(const QString& dumpPath, const QString& csvPath);
+
+private:
+    QElapsedTimer m_clock;
+    QVector<TelemetryFrame> m_ring;
+    TelemetryFrame* m_slots = nullptr;
+    quint32 m_written = 0;
+    float m_renderMs = 0;
+};
+
+#endif // TELEMETRY_H
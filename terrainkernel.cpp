@@ -0,0 +1,164 @@
+// terrainkernel.cpp
+#include "terrainkernel.h"
+#include "constants.h"
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#include <cstring>
+#endif
+
+namespace {
+
+// Nightlife highway: asphalt with a lighter top edge and a yellow dashed line.
+constexpr quint32 ROAD_EDGE    = 0xFF505055u;
+constexpr quint32 ROAD_STRIPE  = 0xFFF0BE28u;
+constexpr quint32 ROAD_ASPHALT = 0xFF323237u;
+constexpr int ROAD_DEPTH   = 14;
+constexpr int GRASS_DEPTH  = 3 * Constants::SHADING_BLOCK;
+
+template <bool Highway>
+inline void shadeScalar(const TerrainRow& r, quint32* out, int from) {
+    const qint32 y = r.row;
+    for (int c = from; c < r.columns; ++c) {
+        const qint32 start = r.start[c];
+        if (y < start) continue;
+        const qint32 surface = r.surface[c];
+        const int depth = y - start;
+        if (Highway && depth < ROAD_DEPTH) {
+            if (depth == 0) out[c] = ROAD_EDGE;
+            else if ((depth == 6 || depth == 7) && r.stripe[c]) out[c] = ROAD_STRIPE;
+            else out[c] = ROAD_ASPHALT;
+            continue;
+        }
+        const quint8 m = r.material[c];
+        if (!Highway && y == surface) out[c] = r.edgeLut[m & 0x0F];
+        else if (y < surface + GRASS_DEPTH) out[c] = r.grassLut[m & 0x0F];
+        else out[c] = r.dirtLut[m >> 4];
+    }
+}
+
+#if defined(__AVX2__)
+
+template <bool Highway>
+int shadeAvx2(const TerrainRow& r, quint32* out) {
+    const __m256i y      = _mm256_set1_epi32(r.row);
+    const __m256i nib    = _mm256_set1_epi32(0x0F);
+    const __m256i grassD = _mm256_set1_epi32(GRASS_DEPTH);
+    const __m256i hw     = _mm256_set1_epi32(Highway ? -1 : 0);
+    const __m256i zero   = _mm256_setzero_si256();
+
+    int c = 0;
+    for (; c + 8 <= r.columns; c += 8) {
+        const __m256i start   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r.start + c));
+        const __m256i valid   = _mm256_cmpgt_epi32(_mm256_add_epi32(y, _mm256_set1_epi32(1)), start);
+        if (_mm256_testz_si256(valid, valid)) continue;
+
+        const __m256i surface = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r.surface + c));
+        const __m256i m  = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r.material + c)));
+        const __m256i gi = _mm256_and_si256(m, nib);
+        const __m256i di = _mm256_srli_epi32(m, 4);
+
+        const __m256i grass = _mm256_i32gather_epi32(reinterpret_cast<const int*>(r.grassLut), gi, 4);
+        const __m256i dirt  = _mm256_i32gather_epi32(reinterpret_cast<const int*>(r.dirtLut), di, 4);
+        const __m256i edge  = _mm256_i32gather_epi32(reinterpret_cast<const int*>(r.edgeLut), gi, 4);
+
+        const __m256i inGrass = _mm256_cmpgt_epi32(_mm256_add_epi32(surface, grassD), y);
+        __m256i col = _mm256_blendv_epi8(dirt, grass, inGrass);
+        const __m256i onEdge = _mm256_andnot_si256(hw, _mm256_cmpeq_epi32(y, surface));
+        col = _mm256_blendv_epi8(col, edge, onEdge);
+
+        if constexpr (Highway) {
+            const __m256i depth  = _mm256_sub_epi32(y, start);
+            const __m256i onRoad = _mm256_cmpgt_epi32(_mm256_set1_epi32(ROAD_DEPTH), depth);
+            const __m256i stripe = _mm256_cmpgt_epi32(
+                _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r.stripe + c))), zero);
+            const __m256i dashRow = _mm256_or_si256(_mm256_cmpeq_epi32(depth, _mm256_set1_epi32(6)),
+                                                    _mm256_cmpeq_epi32(depth, _mm256_set1_epi32(7)));
+            __m256i road = _mm256_set1_epi32(int(ROAD_ASPHALT));
+            road = _mm256_blendv_epi8(road, _mm256_set1_epi32(int(ROAD_STRIPE)), _mm256_and_si256(dashRow, stripe));
+            road = _mm256_blendv_epi8(road, _mm256_set1_epi32(int(ROAD_EDGE)), _mm256_cmpeq_epi32(depth, zero));
+            col = _mm256_blendv_epi8(col, road, onRoad);
+        }
+
+        _mm256_maskstore_epi32(reinterpret_cast<int*>(out + c), valid, col);
+    }
+    return c;
+}
+
+#elif defined(__SSE4_1__)
+
+template <bool Highway>
+int shadeSse41(const TerrainRow& r, quint32* out) {
+    const __m128i y      = _mm_set1_epi32(r.row);
+    const __m128i grassD = _mm_set1_epi32(GRASS_DEPTH);
+    const __m128i hw     = _mm_set1_epi32(Highway ? -1 : 0);
+    const __m128i zero   = _mm_setzero_si128();
+
+    int c = 0;
+    for (; c + 4 <= r.columns; c += 4) {
+        const __m128i start = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.start + c));
+        const __m128i valid = _mm_cmpgt_epi32(_mm_add_epi32(y, _mm_set1_epi32(1)), start);
+        if (_mm_testz_si128(valid, valid)) continue;
+
+        const __m128i surface = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.surface + c));
+        // No gather before AVX2: the four table loads stay scalar.
+        const quint8* m = r.material + c;
+        const __m128i grass = _mm_setr_epi32(int(r.grassLut[m[0] & 0x0F]), int(r.grassLut[m[1] & 0x0F]),
+                                             int(r.grassLut[m[2] & 0x0F]), int(r.grassLut[m[3] & 0x0F]));
+        const __m128i dirt  = _mm_setr_epi32(int(r.dirtLut[m[0] >> 4]), int(r.dirtLut[m[1] >> 4]),
+                                             int(r.dirtLut[m[2] >> 4]), int(r.dirtLut[m[3] >> 4]));
+        const __m128i edge  = _mm_setr_epi32(int(r.edgeLut[m[0] & 0x0F]), int(r.edgeLut[m[1] & 0x0F]),
+                                             int(r.edgeLut[m[2] & 0x0F]), int(r.edgeLut[m[3] & 0x0F]));
+
+        const __m128i inGrass = _mm_cmpgt_epi32(_mm_add_epi32(surface, grassD), y);
+        __m128i col = _mm_blendv_epi8(dirt, grass, inGrass);
+        const __m128i onEdge = _mm_andnot_si128(hw, _mm_cmpeq_epi32(y, surface));
+        col = _mm_blendv_epi8(col, edge, onEdge);
+
+        if constexpr (Highway) {
+            const __m128i depth  = _mm_sub_epi32(y, start);
+            const __m128i onRoad = _mm_cmpgt_epi32(_mm_set1_epi32(ROAD_DEPTH), depth);
+            int stripeBytes;
+            std::memcpy(&stripeBytes, r.stripe + c, sizeof(stripeBytes));
+            const __m128i stripe = _mm_cmpgt_epi32(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(stripeBytes)), zero);
+            const __m128i dashRow = _mm_or_si128(_mm_cmpeq_epi32(depth, _mm_set1_epi32(6)),
+                                                 _mm_cmpeq_epi32(depth, _mm_set1_epi32(7)));
+            __m128i road = _mm_set1_epi32(int(ROAD_ASPHALT));
+            road = _mm_blendv_epi8(road, _mm_set1_epi32(int(ROAD_STRIPE)), _mm_and_si128(dashRow, stripe));
+            road = _mm_blendv_epi8(road, _mm_set1_epi32(int(ROAD_EDGE)), _mm_cmpeq_epi32(depth, zero));
+            col = _mm_blendv_epi8(col, road, onRoad);
+        }
+
+        __m128i* dst = reinterpret_cast<__m128i*>(out + c);
+        _mm_storeu_si128(dst, _mm_blendv_epi8(_mm_loadu_si128(dst), col, valid));
+    }
+    return c;
+}
+
+#endif
+
+} // namespace
+
+template <bool Highway>
+void shadeTerrainRow(const TerrainRow& r, quint32* out) {
+#if defined(__AVX2__)
+    shadeScalar<Highway>(r, out, shadeAvx2<Highway>(r, out));
+#elif defined(__SSE4_1__)
+    shadeScalar<Highway>(r, out, shadeSse41<Highway>(r, out));
+#else
+    shadeScalar<Highway>(r, out, 0);
+#endif
+}
+
+template void shadeTerrainRow<false>(const TerrainRow&, quint32*);
+template void shadeTerrainRow<true>(const TerrainRow&, quint32*);
+
+const char* terrainKernelName() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE4_1__)
+    return "sse4.1";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,40 @@
+// terrainkernel.h
+#ifndef TERRAINKERNEL_H
+#define TERRAINKERNEL_H
+
+#include <QtGlobal>
+
+// Shades one screen row of terrain for a run of columns, several columns per
+// instruction: AVX2 (8 lanes) or SSE4.1 (4 lanes) depending on what the build
+// targets, with a scalar loop for the tail and for plain builds.
+//
+// Per column the caller supplies the surface row and the first shaded row
+// (the surface clamped to the top of the screen), and per row the material
+// byte of every column's shading block (see TerrainMaterialCache).
+struct TerrainRow {
+    // Rows at or beyond this mark a column with no terrain on screen.
+    static constexpr qint32 NO_SURFACE = 1 << 29;
+
+    const qint32* surface = nullptr;
+    const qint32* start = nullptr;
+    const quint8* material = nullptr;
+    const quint8* stripe = nullptr;   // highway: 1 where the dashed line runs
+    const quint32* grassLut = nullptr; // 16 entries each
+    const quint32* dirtLut = nullptr;
+    const quint32* edgeLut = nullptr;
+    qint32 row = 0;
+    int columns = 0;
+};
+
+// Writes the terrain cells of `r.row` into out[0..columns); sky cells are left
+// untouched so stars and clouds already drawn there survive. `Highway` paves
+// the top rows as the Nightlife road instead of grass.
+template <bool Highway>
+void shadeTerrainRow(const TerrainRow& r, quint32* out);
+
+using TerrainShadeFn = void (*)(const TerrainRow& r, quint32* out);
+
+// Name of the code path shadeTerrainRow was compiled with.
+const char* terrainKernelName();
+
+#endif // TERRAINKERNEL_H
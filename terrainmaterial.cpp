@@ -0,0 +1,43 @@
+// terrainmaterial.cpp
+#include "terrainmaterial.h"
+#include <algorithm>
+
+void TerrainMaterialCache::setLevel(const LevelData& level) {
+    m_grassCount = std::clamp(int(level.grassPalette.size()), 1, int(MAX_PALETTE));
+    m_dirtCount  = std::clamp(int(level.dirtPalette.size()),  1, int(MAX_PALETTE));
+    for (int i = 0; i < MAX_PALETTE; ++i) {
+        const QColor g = level.grassPalette[i % m_grassCount];
+        const QColor d = level.dirtPalette[i % m_dirtCount];
+        m_grass[i] = g.rgba();
+        m_dirt[i]  = d.rgba();
+        m_edge[i]  = g.darker(115).rgba();
+    }
+    m_columns.clear();
+}
+
+quint8 TerrainMaterialCache::computeMaterial(int bx, int by) const {
+    const quint32 h = hash(bx, by);
+    return quint8((h % quint32(m_grassCount)) | ((h % quint32(m_dirtCount)) << 4));
+}
+
+void TerrainMaterialCache::addColumn(int worldGX, int groundWorldGY) {
+    const int bx = worldGX / Constants::SHADING_BLOCK;
+    const int byTop = groundWorldGY / Constants::SHADING_BLOCK;
+
+    Column& col = m_columns[bx];
+    if (!col.idx.isEmpty() && byTop >= col.by0) return;
+
+    // New column, or a neighbouring cell of this block column sits higher:
+    // (re)fill from the new top so every visible block is covered.
+    col.by0 = byTop;
+    col.idx.resize(DEPTH_BLOCKS);
+    for (int k = 0; k < DEPTH_BLOCKS; ++k) col.idx[k] = computeMaterial(bx, byTop + k);
+}
+
+void TerrainMaterialCache::prune(int minWorldGX) {
+    const int minBX = minWorldGX / Constants::SHADING_BLOCK - 1;
+    for (auto it = m_columns.begin(); it != m_columns.end(); ) {
+        if (it.key() < minBX) it = m_columns.erase(it);
+        else ++it;
+    }
+}
@@ -0,0 +1,77 @@
+// terrainmaterial.h
+#ifndef TERRAINMATERIAL_H
+#define TERRAINMATERIAL_H
+
+#include <QHash>
+#include <QRgb>
+#include <QVector>
+#include <array>
+#include "constants.h"
+
+// Per-biome terrain shading, precomputed as terrain is generated.
+// Every SHADING_BLOCK x SHADING_BLOCK block below the surface gets one byte with
+// its grass palette index in the low nibble and its dirt palette index in the
+// high nibble; drawing only has to expand those through the 16-entry ARGB tables.
+class TerrainMaterialCache {
+public:
+    static constexpr int MAX_PALETTE  = 16;
+    static_assert(LevelData::PALETTE_SIZE <= MAX_PALETTE, "palette index must fit in a nibble");
+    // Blocks stored below the surface block of each block column; deeper cells
+    // (only visible on very tall windows) fall back to hashing.
+    static constexpr int DEPTH_BLOCKS = 128;
+
+    struct Column {
+        int by0 = 0;
+        QVector<quint8> idx;
+    };
+
+    // Rebuilds the lookup tables for the biome and drops all columns.
+    void setLevel(const LevelData& level);
+    void clear() { m_columns.clear(); }
+
+    // Called for every heightmap entry; makes sure the block column holding
+    // worldGX covers everything from the surface block down.
+    void addColumn(int worldGX, int groundWorldGY);
+    void prune(int minWorldGX);
+
+    const Column* column(int bx) const {
+        auto it = m_columns.constFind(bx);
+        return (it == m_columns.constEnd()) ? nullptr : &it.value();
+    }
+
+    // Material byte of a block; `col` is column(bx) and may be null.
+    quint8 material(const Column* col, int bx, int by) const {
+        if (col) {
+            const int k = by - col->by0;
+            if (k >= 0 && k < col->idx.size()) return col->idx[k];
+        }
+        return computeMaterial(bx, by);
+    }
+
+    QRgb grass(quint8 m) const { return m_grass[m & 0x0F]; }
+    QRgb dirt(quint8 m)  const { return m_dirt[m >> 4]; }
+    QRgb edge(quint8 m)  const { return m_edge[m & 0x0F]; }
+    const QRgb* grassTable() const { return m_grass.data(); }
+    const QRgb* dirtTable()  const { return m_dirt.data(); }
+    const QRgb* edgeTable()  const { return m_edge.data(); }
+
+    // The block hash the terrain has always been shaded with.
+    static inline quint32 hash(int x, int y) {
+        quint32 h = 120003212u;
+        h ^= quint32(x); h *= 16777619u;
+        h ^= quint32(y); h *= 16777619u;
+        return (h ^ x) / (h ^ y) + (x * y) - (3 * x*x + 4 * y*y);
+    }
+
+private:
+    quint8 computeMaterial(int bx, int by) const;
+
+    QHash<int, Column> m_columns;
+    int m_grassCount = 1;
+    int m_dirtCount = 1;
+    std::array<QRgb, MAX_PALETTE> m_grass{};
+    std::array<QRgb, MAX_PALETTE> m_dirt{};
+    std::array<QRgb, MAX_PALETTE> m_edge{};
+};
+
+#endif // TERRAINMATERIAL_H
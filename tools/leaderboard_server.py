@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# leaderboard_server.py
+"""Local stand-in for the shared leaderboard service.
+
+Run it, then start the game with BB_LEADERBOARD_URL=http://127.0.0.1:8765
+
+    POST /runs   {"d": device, "o": first run number, "r": [[stage, score, ...], ...]}
+                 Runs the device already sent (by run number) are ignored.
+                 -> {"n": runs stored for the device}
+    GET  /best   -> {"b": [[stage, best score], ...]}
+
+--fail-rate and --delay make requests fail or stall, to exercise the
+client's retry and backoff.
+"""
+import argparse
+import json
+import random
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+runs = {}  # device -> list of run arrays, indexed by run number
+lock = threading.Lock()
+
+
+class Handler(BaseHTTPRequestHandler):
+    def reply(self, code, body):
+        data = json.dumps(body, separators=(",", ":")).encode()
+        self.send_response(code)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def misbehave(self):
+        time.sleep(self.server.args.delay)
+        if random.random() < self.server.args.fail_rate:
+            self.reply(503, {"error": "injected failure"})
+            return True
+        return False
+
+    def do_POST(self):
+        if self.path.rstrip("/").split("/")[-1] != "runs":
+            return self.reply(404, {"error": "not found"})
+        if self.misbehave():
+            return
+        try:
+            body = json.loads(self.rfile.read(int(self.headers.get("Content-Length", 0))))
+            device, offset, batch = str(body["d"]), int(body["o"]), list(body["r"])
+        except (ValueError, KeyError, TypeError):
+            return self.reply(400, {"error": "bad batch"})
+        with lock:
+            stored = runs.setdefault(device, [])
+            # Runs the client skipped after a rejected batch leave a gap.
+            stored.extend([None] * (offset - len(stored)))
+            for i, run in enumerate(batch):
+                if offset + i >= len(stored):
+                    stored.append(run)
+            count = len(stored)
+        self.reply(200, {"n": count})
+
+    def do_GET(self):
+        if self.path.rstrip("/").split("/")[-1] != "best":
+            return self.reply(404, {"error": "not found"})
+        if self.misbehave():
+            return
+        best = {}
+        with lock:
+            for stored in runs.values():
+                for run in filter(None, stored):
+                    stage, score = int(run[0]), int(run[1])
+                    best[stage] = max(best.get(stage, score), score)
+        self.reply(200, {"b": sorted([s, b] for s, b in best.items())})
+
+    def log_message(self, fmt, *args):
+        if not self.server.args.quiet:
+            super().log_message(fmt, *args)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--port", type=int, default=8765)
+    ap.add_argument("--fail-rate", type=float, default=0.0, help="share of requests answered with 503")
+    ap.add_argument("--delay", type=float, default=0.0, help="seconds to wait before answering")
+    ap.add_argument("--quiet", action="store_true")
+    args = ap.parse_args()
+
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+    server.args = args
+    print(f"leaderboard stand-in on http://127.0.0.1:{args.port}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,104 @@
+// main.cpp
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+#include "constants.h"
+#include "pixelfont.h"
+
+namespace {
+
+constexpr int WIDTH  = 1280;
+constexpr int HEIGHT = 720;
+constexpr int FRAMES = 2000;
+
+// IntroScreen::drawPixelText before PixelFont: one fillRect per lit sub-cell,
+// plus four more per sub-cell for the bold halo.
+void drawPerCell(QPainter& p, const QString& s, int gx, int gy, int scale, const QColor& c, bool bold) {
+    const int gridW = WIDTH / Constants::PIXEL_SIZE, gridH = HEIGHT / Constants::PIXEL_SIZE;
+    auto plot = [&](int x, int y) {
+        x += gx; y += gy;
+        if (x < 0 || y < 0 || x >= gridW + 1 || y >= gridH + 1) return;
+        p.fillRect(x * Constants::PIXEL_SIZE, y * Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, Constants::PIXEL_SIZE, c);
+    };
+
+    for (int i = 0; i < s.size(); ++i) {
+        const Glyph& rows = font_map.glyph(s.at(i).toUpper());
+        const int baseOff = i * 7 * scale;
+        for (int ry = 0; ry < 7; ++ry) {
+            for (int rx = 0; rx < 5; ++rx) {
+                if (!(rows[ry] & (1 << (4 - rx)))) continue;
+                for (int sy = 0; sy < scale; ++sy) {
+                    for (int sx = 0; sx < scale; ++sx) {
+                        const int x = baseOff + rx * scale + sx, y = ry * scale + sy;
+                        if (bold) {
+                            plot(x - 1, y);
+                            plot(x + 1, y);
+                            plot(x, y - 1);
+                            plot(x, y + 1);
+                        }
+                        plot(x, y);
+                    }
+                }
+            }
+        }
+    }
+}
+
+struct Timing {
+    double firstUs;
+    double medianUs;
+};
+
+// Draws FRAMES frames onto a cleared backdrop and times only the text.
+template <typename Draw>
+Timing timeFrames(QImage& img, Draw&& draw) {
+    std::vector<double> us;
+    us.reserve(FRAMES);
+    QElapsedTimer t;
+    for (int f = 0; f < FRAMES; ++f) {
+        img.fill(Constants::LEVELS[0].skyColor);
+        QPainter p(&img);
+        t.start();
+        draw(p);
+        us.push_back(t.nsecsElapsed() / 1e3);
+    }
+    const double first = us.front();
+    std::nth_element(us.begin(), us.begin() + FRAMES / 2, us.end());
+    return {first, us[FRAMES / 2]};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QGuiApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    const QColor color = Constants::LEVELS[0].textColor;
+    const QString title = QStringLiteral("Braking Bad");
+    QImage before(WIDTH, HEIGHT, QImage::Format_ARGB32_Premultiplied);
+    QImage after(WIDTH, HEIGHT, QImage::Format_ARGB32_Premultiplied);
+
+    out << "\"" << title << "\" bold, " << WIDTH << "x" << HEIGHT << ", median of " << FRAMES << " frames\n";
+    for (int scale = 2; scale <= 4; ++scale) {
+        PixelFont font(font_map, 7, true);      // fresh caches, so the first frame pays the build
+        const int gx = (WIDTH / Constants::PIXEL_SIZE - font.widthCells(title, scale)) / 2;
+        const int gy = HEIGHT / Constants::PIXEL_SIZE / 4;
+
+        const Timing a = timeFrames(before, [&](QPainter& p) { drawPerCell(p, title, gx, gy, scale, color, true); });
+        const Timing b = timeFrames(after, [&](QPainter& p) {
+            font.draw(p, title, gx, gy, Constants::PIXEL_SIZE, scale, color, true);
+        });
+
+        out << QStringLiteral("scale %1: fillRect per cell %2 us | PixelFont %3 us (first frame %4 us) | %5\n")
+                   .arg(scale)
+                   .arg(a.medianUs, 0, 'f', 1)
+                   .arg(b.medianUs, 0, 'f', 1)
+                   .arg(b.firstUs, 0, 'f', 1)
+                   .arg(before == after ? QStringLiteral("identical") : QStringLiteral("PIXELS DIFFER"));
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+# pixelfont_bench.pro
+#
+# Times the intro title drawn through PixelFont against the per-cell
+# fillRect loop it replaced. Build and run from this directory:
+#   qmake && make && ./pixelfont_bench
+
+QT      += gui
+CONFIG  += c++17 console
+CONFIG  -= app_bundle
+
+TARGET   = pixelfont_bench
+TEMPLATE = app
+
+INCLUDEPATH += ../..
+
+HEADERS += \
+    ../../constants.h \
+    ../../pixelfont.h
+
+SOURCES += \
+    main.cpp \
+    ../../pixelfont.cpp
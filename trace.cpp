@@ -0,0 +1,173 @@
+// trace.cpp
+#include "trace.h"
+
+#if defined(BB_PERF_PROBES)
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QMutex>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct Event {
+    const char* name;
+    qint64 startNs;
+    qint64 durNs;
+};
+
+struct ThreadBuffer {
+    std::unique_ptr<Event[]> events{new Event[Trace::EVENTS_PER_THREAD]};
+    std::atomic<quint64> head{0};
+    int tid = 0;
+    QByteArray name;
+};
+
+// Buffers outlive their threads so a trace still shows work done by threads
+// that have since exited. Pool threads retire after 30 s idle and come back
+// as new threads, so a buffer whose thread has exited goes on s_free and the
+// next new thread takes it over (events, row and all) instead of adding one.
+QMutex s_registryLock;
+std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+std::vector<ThreadBuffer*> s_free;
+thread_local ThreadBuffer* t_buffer = nullptr;
+
+struct Registration {
+    ~Registration() {
+        if (!t_buffer) return;
+        QMutexLocker lock(&s_registryLock);
+        s_free.push_back(t_buffer);
+    }
+};
+thread_local Registration t_registration;
+
+std::atomic<bool> s_active{false};
+qint64 s_hitchNs = 0;
+qint64 s_lastAutoWriteMs = -1;
+
+ThreadBuffer* threadBuffer() {
+    if (t_buffer) return t_buffer;
+    const QThread* thread = QThread::currentThread();
+    static_cast<void>(&t_registration); // constructs it, so its destructor runs at thread exit
+    QMutexLocker lock(&s_registryLock);
+    ThreadBuffer* b = nullptr;
+    if (!s_free.empty()) {
+        b = s_free.back();
+        s_free.pop_back();
+    } else {
+        s_buffers.push_back(std::make_unique<ThreadBuffer>());
+        b = s_buffers.back().get();
+        b->tid = int(s_buffers.size());
+    }
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+        b->name = QByteArrayLiteral("GUI");
+    else if (!thread->objectName().isEmpty())
+        b->name = thread->objectName().toUtf8();
+    else
+        b->name = QByteArrayLiteral("worker ") + QByteArray::number(b->tid);
+    t_buffer = b;
+    return t_buffer;
+}
+
+struct Snapshot {
+    int tid;
+    QByteArray name;
+    std::vector<Event> events;
+};
+
+// {"traceEvents":[...]} with one complete ("X") event per scope and a
+// thread_name metadata event per thread; times in microseconds.
+QByteArray toJson(const std::vector<Snapshot>& threads) {
+    QByteArray out;
+    out.reserve(1 << 20);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto sep = [&] { if (!first) out += ",\n"; first = false; };
+    for (const Snapshot& t : threads) {
+        sep();
+        out += "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" + QByteArray::number(t.tid)
+             + ",\"args\":{\"name\":\"" + t.name + "\"}}";
+        for (const Event& e : t.events) {
+            sep();
+            out += "{\"ph\":\"X\",\"name\":\"";
+            out += e.name;
+            out += "\",\"pid\":1,\"tid\":" + QByteArray::number(t.tid)
+                 + ",\"ts\":" + QByteArray::number(e.startNs / 1e3, 'f', 3)
+                 + ",\"dur\":" + QByteArray::number(e.durNs / 1e3, 'f', 3) + '}';
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+} // namespace
+
+void Trace::init() {
+    bool ok = false;
+    const int hitchMs = qEnvironmentVariableIntValue("BB_TRACE_HITCH_MS", &ok);
+    if (ok && hitchMs > 0) s_hitchNs = qint64(hitchMs) * 1000000;
+    s_active.store(qEnvironmentVariableIntValue("BB_TRACE") != 0 || s_hitchNs > 0, std::memory_order_relaxed);
+}
+
+bool Trace::active() {
+    return s_active.load(std::memory_order_relaxed);
+}
+
+void Trace::complete(const char* name, qint64 startNs, qint64 durNs) {
+    ThreadBuffer* b = threadBuffer();
+    const quint64 head = b->head.load(std::memory_order_relaxed);
+    b->events[head & (EVENTS_PER_THREAD - 1)] = Event{name, startNs, durNs};
+    b->head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::frameFinished(qint64 frameNs) {
+    if (s_hitchNs <= 0 || frameNs <= s_hitchNs) return;
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (s_lastAutoWriteMs >= 0 && nowMs - s_lastAutoWriteMs < HITCH_COOLDOWN_MS) return;
+    s_lastAutoWriteMs = nowMs;
+    write("hitch");
+}
+
+bool Trace::write(const char* reason) {
+    if (!active()) return false;
+
+    std::vector<Snapshot> threads;
+    {
+        QMutexLocker lock(&s_registryLock);
+        threads.reserve(s_buffers.size());
+        for (const auto& b : s_buffers) {
+            const quint64 head = b->head.load(std::memory_order_acquire);
+            const quint64 n = std::min<quint64>(head, EVENTS_PER_THREAD);
+            Snapshot s{ b->tid, b->name, {} };
+            s.events.reserve(n);
+            for (quint64 i = head - n; i < head; ++i) s.events.push_back(b->events[i & (EVENTS_PER_THREAD - 1)]);
+            threads.push_back(std::move(s));
+        }
+    }
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    const QString path = dir + QStringLiteral("/trace-%1-%2.json")
+                                   .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-hhmmss")),
+                                        QLatin1String(reason));
+    QThreadPool::globalInstance()->start([threads = std::move(threads), dir, path] {
+        QDir().mkpath(dir);
+        QSaveFile f(path);
+        if (f.open(QIODevice::WriteOnly) && f.write(toJson(threads)) >= 0 && f.commit())
+            qInfo().noquote() << "trace written to" << path;
+        else
+            qWarning().noquote() << "trace: could not write" << path;
+    });
+    return true;
+}
+
+#endif // BB_PERF_PROBES
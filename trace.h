@@ -0,0 +1,63 @@
+// trace.h
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+#include <QtGlobal>
+#include "perfprobe.h"
+
+// Chrome trace-event recorder; the output loads in Perfetto or
+// chrome://tracing. Compiled in with the perf probes (BB_PERF_PROBES) and
+// switched on at run time:
+//   BB_TRACE=1            record; F9 writes the trace
+//   BB_TRACE_HITCH_MS=n   record, and write the trace by itself after any
+//                         frame slower than n ms (at most every HITCH_COOLDOWN_MS)
+// Every PERF_SCOPE becomes an event too, so the phase names match the overlay.
+//
+// Each thread records complete events (name, start, duration) into its own
+// fixed ring and keeps the newest EVENTS_PER_THREAD. Recording is a few plain
+// stores plus one release store: no lock and, after the thread's first event,
+// no allocation. write() copies the rings on the calling thread and formats
+// and saves the JSON on a pool thread. A ring that wraps during that copy can
+// contribute a few torn events, which only costs accuracy in the trace.
+namespace Trace {
+
+#if defined(BB_PERF_PROBES)
+
+constexpr int EVENTS_PER_THREAD = 1 << 15;
+constexpr int HITCH_COOLDOWN_MS = 10000;
+
+// Reads the environment; call once at startup.
+void init();
+bool active();
+// name must have static storage duration (a string literal).
+void complete(const char* name, qint64 startNs, qint64 durNs);
+// GUI thread: checks the frame against the hitch threshold.
+void frameFinished(qint64 frameNs);
+// Saves trace-<time>-<reason>.json under AppDataLocation; false if inactive.
+bool write(const char* reason);
+
+class Scope {
+public:
+    explicit Scope(const char* name) : m_name(active() ? name : nullptr), m_start(m_name ? Perf::nowNs() : 0) {}
+    ~Scope() { if (m_name) complete(m_name, m_start, Perf::nowNs() - m_start); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+private:
+    const char* m_name;
+    qint64 m_start;
+};
+
+#define TRACE_SCOPE(name) const Trace::Scope PERF_CAT(traceScope_, __LINE__)(name)
+
+#else
+
+inline void init() {}
+inline bool write(const char*) { return false; }
+#define TRACE_SCOPE(name) ((void)0)
+
+#endif
+
+} // namespace Trace
+
+#endif // TRACE_H
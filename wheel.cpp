@@ -48,10 +48,11 @@ void Wheel::updateV(double dvx, double dvy){
     m_vy+=dvy;
 }
 
-void Wheel::simulate(int level_index, const QList<Line>& lines, bool accelerating, bool braking, bool nitro)
+template <int Level>
+void Wheel::simulate(const QList<Line>& lines, bool accelerating, bool braking, bool nitro)
 {
     // Access the specific level data
-    const auto& level = Constants::LEVELS[level_index];
+    constexpr const LevelPhysics& level = Constants::LEVEL_PHYSICS[Level];
 
     // integrate position
     x += m_vx;
@@ -231,3 +232,11 @@ std::optional<std::array<int, 3>> Wheel::get(int x1, int y1, int x2, int y2, int
         m_radius
     };
 }
+
+static_assert(Constants::LEVEL_COUNT == 6, "instantiate Wheel::simulate for every biome");
+template void Wheel::simulate<0>(const QList<Line>&, bool, bool, bool);
+template void Wheel::simulate<1>(const QList<Line>&, bool, bool, bool);
+template void Wheel::simulate<2>(const QList<Line>&, bool, bool, bool);
+template void Wheel::simulate<3>(const QList<Line>&, bool, bool, bool);
+template void Wheel::simulate<4>(const QList<Line>&, bool, bool, bool);
+template void Wheel::simulate<5>(const QList<Line>&, bool, bool, bool);
@@ -21,8 +21,9 @@ public:
 
     void attach(Wheel* other);
 
-    // signature with nitro stays
-    void simulate(int, const QList<Line>& lines, bool accelerating, bool braking, bool nitro);
+    // signature with nitro stays; instantiated once per biome (see stagepaths.h)
+    template <int Level>
+    void simulate(const QList<Line>& lines, bool accelerating, bool braking, bool nitro);
 
     // (centerX, centerY, radius) for rendering after camera offset
     std::optional<std::array<int, 3>> get(int x1, int y1, int x2, int y2, int cx, int cy) const;